@@ -90,6 +90,8 @@ struct StickersListWidget::Sticker {
 	QImage savedFrame;
 	QSize savedFrameFor;
 	QImage premiumLock;
+	bool savedFrameRequested = false;
+	bool savedFrameCached = false;
 
 	void ensureMediaCreated();
 };
@@ -867,6 +869,8 @@ void StickersListWidget::takeHeavyData(Sticker &to, Sticker &from) {
 	to.documentMedia = std::move(from.documentMedia);
 	to.savedFrame = std::move(from.savedFrame);
 	to.savedFrameFor = from.savedFrameFor;
+	to.savedFrameRequested = from.savedFrameRequested;
+	to.savedFrameCached = from.savedFrameCached;
 	to.lottie = base::take(from.lottie);
 	to.webm = base::take(from.webm);
 }
@@ -1206,6 +1210,9 @@ void StickersListWidget::clearHeavyIn(Set &set, bool clearSavedFrames) {
 		if (clearSavedFrames) {
 			sticker.savedFrame = QImage();
 			sticker.savedFrameFor = QSize();
+			sticker.savedFrameRequested = false;
+			sticker.savedFrameCached = false;
+			_cachedFrames.remove(sticker.document);
 		}
 		sticker.webm = nullptr;
 		sticker.lottie = nullptr;
@@ -1338,6 +1345,51 @@ void StickersListWidget::setupWebm(Set &set, int section, int index) {
 		std::move(callback));
 }
 
+void StickersListWidget::validateSavedFrame(Sticker &sticker) {
+	const auto document = sticker.document;
+	const auto i = _cachedFrames.find(document);
+	if (i != end(_cachedFrames)) {
+		// A cached frame replaces the thumbnail fallback, if any.
+		if (!sticker.savedFrameCached) {
+			sticker.savedFrame = std::move(i->second);
+			sticker.savedFrame.setDevicePixelRatio(
+				style::DevicePixelRatio());
+			sticker.savedFrameFor = _singleSize;
+			sticker.savedFrameCached = true;
+		}
+		_cachedFrames.erase(i);
+		return;
+	} else if (sticker.savedFrameCached || sticker.savedFrameRequested) {
+		return;
+	}
+	sticker.savedFrameRequested = true;
+	const auto box = _singleSize * style::DevicePixelRatio();
+	LoadStickerFirstFrame(
+		document,
+		StickerLottieSize::StickersPanel,
+		box,
+		crl::guard(this, [=](QImage frame) {
+			if (frame.isNull()
+				|| box != _singleSize * style::DevicePixelRatio()) {
+				return;
+			}
+			_cachedFrames[document] = std::move(frame);
+			update();
+		}));
+}
+
+void StickersListWidget::storeSavedFrame(Sticker &sticker, QImage frame) {
+	sticker.savedFrame = std::move(frame);
+	sticker.savedFrame.setDevicePixelRatio(style::DevicePixelRatio());
+	sticker.savedFrameFor = _singleSize;
+	sticker.savedFrameCached = true;
+	SaveStickerFirstFrame(
+		sticker.document,
+		StickerLottieSize::StickersPanel,
+		_singleSize * style::DevicePixelRatio(),
+		sticker.savedFrame);
+}
+
 void StickersListWidget::clipCallback(
 		Media::Clip::Notification notification,
 		uint64 setId,
@@ -1508,6 +1560,9 @@ void StickersListWidget::paintSticker(
 	}
 
 	media->checkStickerSmall();
+	if ((isLottie || isWebm) && !sticker.lottie && !sticker.webm) {
+		validateSavedFrame(sticker);
+	}
 
 	const auto size = ComputeStickerSize(document, boundingBoxSize());
 	const auto ppos = pos + QPoint(
@@ -1518,26 +1573,24 @@ void StickersListWidget::paintSticker(
 	if (sticker.lottie && sticker.lottie->ready()) {
 		auto request = Lottie::FrameRequest();
 		request.box = boundingBoxSize() * style::DevicePixelRatio();
-		lottieFrame = sticker.lottie->frame(request);
+		const auto info = sticker.lottie->frameInfo(request);
+		lottieFrame = info.image;
 		p.drawImage(
 			QRect(ppos, lottieFrame.size() / style::DevicePixelRatio()),
 			lottieFrame);
-		if (sticker.savedFrame.isNull()) {
-			sticker.savedFrame = lottieFrame;
-			sticker.savedFrame.setDevicePixelRatio(style::DevicePixelRatio());
-			sticker.savedFrameFor = _singleSize;
+		if (!sticker.savedFrameCached && !info.index) {
+			storeSavedFrame(sticker, lottieFrame);
 		}
 		set.lottiePlayer->unpause(sticker.lottie);
 	} else if (sticker.webm && sticker.webm->started()) {
-		const auto frame = sticker.webm->current(
+		const auto info = sticker.webm->frameInfo(
 			{ .frame = size, .keepAlpha = true },
 			paused ? 0 : now);
-		if (sticker.savedFrame.isNull()) {
-			sticker.savedFrame = frame;
-			sticker.savedFrame.setDevicePixelRatio(style::DevicePixelRatio());
-			sticker.savedFrameFor = _singleSize;
+		sticker.webm->moveToNextFrame();
+		if (!sticker.savedFrameCached && !info.index) {
+			storeSavedFrame(sticker, info.image);
 		}
-		p.drawImage(ppos, frame);
+		p.drawImage(ppos, info.image);
 	} else {
 		const auto image = media->getStickerSmall();
 		const auto useSavedFrame = !sticker.savedFrame.isNull()
@@ -2097,6 +2150,28 @@ void StickersListWidget::clearHeavyData() {
 	for (auto &set : shownSets()) {
 		clearHeavyIn(set, false);
 	}
+	_cachedFrames.clear();
+}
+
+void StickersListWidget::pruneCachedFrames() {
+	if (_cachedFrames.empty()) {
+		return;
+	}
+	auto shown = base::flat_set<not_null<DocumentData*>>();
+	for (const auto &set : shownSets()) {
+		for (const auto &sticker : set.stickers) {
+			if (!sticker.savedFrameCached) {
+				shown.emplace(sticker.document);
+			}
+		}
+	}
+	for (auto i = begin(_cachedFrames); i != end(_cachedFrames);) {
+		if (shown.contains(i->first)) {
+			++i;
+		} else {
+			i = _cachedFrames.erase(i);
+		}
+	}
 }
 
 void StickersListWidget::refreshStickers() {
@@ -2115,6 +2190,7 @@ void StickersListWidget::refreshStickers() {
 		refreshFooterIcons();
 	}
 	refreshSettingsVisibility();
+	pruneCachedFrames();
 
 	_lastMousePosition = QCursor::pos();
 	updateSelected();
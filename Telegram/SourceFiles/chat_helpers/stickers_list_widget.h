@@ -299,6 +299,9 @@ private:
 	void ensureLottiePlayer(Set &set);
 	void setupLottie(Set &set, int section, int index);
 	void setupWebm(Set &set, int section, int index);
+	void validateSavedFrame(Sticker &sticker);
+	void storeSavedFrame(Sticker &sticker, QImage frame);
+	void pruneCachedFrames();
 	void clipCallback(
 		Media::Clip::Notification notification,
 		uint64 setId,
@@ -431,6 +434,7 @@ private:
 	Ui::RoundRect _groupCategoryAddBgOver, _groupCategoryAddBg;
 
 	const std::unique_ptr<Ui::PathShiftGradient> _pathGradient;
+	base::flat_map<not_null<DocumentData*>, QImage> _cachedFrames;
 
 	Ui::Text::String _megagroupSetAbout;
 	QString _megagroupSetButtonText;
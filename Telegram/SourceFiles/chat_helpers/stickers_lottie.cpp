@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/chat/attach/attach_prepare.h"
 #include "ui/effects/path_shift_gradient.h"
 #include "ui/image/image_location_factory.h"
+#include "ui/image/image_prepare.h"
 #include "ui/painter.h"
 #include "main/main_session.h"
 
@@ -31,6 +32,65 @@ namespace {
 
 constexpr auto kDontCacheLottieAfterArea = 512 * 512;
 
+// Replacements tags 1-5 are skin colors, 0x0F is used by custom emoji.
+constexpr auto kFirstFrameReplacementsTag = uint8(0x0E);
+constexpr auto kFirstFrameVersion = qint32(1);
+
+[[nodiscard]] Storage::Cache::Key FirstFrameCacheKey(
+		not_null<DocumentData*> document,
+		StickerLottieSize sizeTag) {
+	const auto baseKey = document->bigFileBaseCacheKey();
+	if (!baseKey) {
+		return {};
+	}
+	return Storage::Cache::Key{
+		baseKey.high,
+		baseKey.low + LottieCacheKeyShift(
+			kFirstFrameReplacementsTag,
+			sizeTag),
+	};
+}
+
+[[nodiscard]] QImage DeserializeFirstFrame(
+		const QByteArray &serialized,
+		QSize box) {
+	if (serialized.isEmpty()) {
+		return QImage();
+	}
+	auto stream = QDataStream(serialized);
+	auto version = qint32();
+	auto size = QSize();
+	auto content = QByteArray();
+	stream >> version >> size >> content;
+	if (stream.status() != QDataStream::Ok
+		|| version != kFirstFrameVersion
+		|| size != box) {
+		return QImage();
+	}
+	auto result = Images::Read({ .content = content }).image;
+	return (result.format() == QImage::Format_ARGB32_Premultiplied)
+		? result
+		: result.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+[[nodiscard]] QByteArray SerializeFirstFrame(
+		const QImage &frame,
+		QSize box) {
+	auto content = QByteArray();
+	{
+		auto buffer = QBuffer(&content);
+		if (!frame.save(&buffer, "PNG")) {
+			return QByteArray();
+		}
+	}
+	auto result = QByteArray();
+	{
+		auto stream = QDataStream(&result, QIODevice::WriteOnly);
+		stream << kFirstFrameVersion << box << content;
+	}
+	return result;
+}
+
 } // namespace
 
 uint8 LottieCacheKeyShift(uint8 replacementsTag, StickerLottieSize sizeTag) {
@@ -204,6 +264,48 @@ std::unique_ptr<Lottie::SinglePlayer> LottieThumbnail(
 		box);
 }
 
+void LoadStickerFirstFrame(
+		not_null<DocumentData*> document,
+		StickerLottieSize sizeTag,
+		QSize box,
+		Fn<void(QImage)> done) {
+	const auto key = FirstFrameCacheKey(document, sizeTag);
+	if (!key) {
+		done(QImage());
+		return;
+	}
+	document->owner().cacheBigFile().get(key, [=](QByteArray &&value) {
+		// Don't decode the PNG on the cache database thread.
+		crl::async([=, value = std::move(value)] {
+			auto image = DeserializeFirstFrame(value, box);
+			crl::on_main([=, image = std::move(image)]() mutable {
+				done(std::move(image));
+			});
+		});
+	});
+}
+
+void SaveStickerFirstFrame(
+		not_null<DocumentData*> document,
+		StickerLottieSize sizeTag,
+		QSize box,
+		QImage frame) {
+	const auto key = FirstFrameCacheKey(document, sizeTag);
+	if (!key || frame.isNull()) {
+		return;
+	}
+	const auto weak = base::make_weak(&document->session());
+	crl::async([=, frame = std::move(frame)] {
+		auto serialized = SerializeFirstFrame(frame, box);
+		if (serialized.isEmpty()) {
+			return;
+		}
+		crl::on_main(weak, [=, data = std::move(serialized)]() mutable {
+			weak->data().cacheBigFile().put(key, std::move(data));
+		});
+	});
+}
+
 bool HasWebmThumbnail(
 		StickerType thumbType,
 		Data::StickersSetThumbnailView *thumb,
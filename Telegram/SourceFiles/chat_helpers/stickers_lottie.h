@@ -103,6 +103,20 @@ enum class StickerLottieSize : uint8 {
 	QSize box,
 	std::shared_ptr<Lottie::FrameRenderer> renderer = nullptr);
 
+// First frames of stickers, kept in the big file cache between launches,
+// so that sticker lists can be painted before the animations are ready.
+// The callback is invoked on the main thread with a null image on a miss.
+void LoadStickerFirstFrame(
+	not_null<DocumentData*> document,
+	StickerLottieSize sizeTag,
+	QSize box,
+	Fn<void(QImage)> done);
+void SaveStickerFirstFrame(
+	not_null<DocumentData*> document,
+	StickerLottieSize sizeTag,
+	QSize box,
+	QImage frame);
+
 [[nodiscard]] bool HasWebmThumbnail(
 	StickerType thumbType,
 	Data::StickersSetThumbnailView *thumb,
@@ -329,22 +329,165 @@ char *hashMd5Hex(const int32 *hashmd5, void *dest) {
 }
 
 namespace {
-	QMap<QString, QString> fastRusEng;
-	QHash<QChar, QString> fastLetterRusEng;
-	QMap<uint32, QString> fastDoubleLetterRusEng;
-	QHash<QChar, QChar> fastRusKeyboardSwitch;
-	QHash<QChar, QChar> fastUkrKeyboardSwitch;
+
+// The tables are filled once and are safe to read from any thread.
+
+[[nodiscard]] const QMap<QString, QString> &FastRusEng() {
+	static const auto table = [] {
+		auto result = QMap<QString, QString>();
+		result.insert(QString::fromUtf8("Александр"), u"Alexander"_q);
+		result.insert(QString::fromUtf8("александр"), u"alexander"_q);
+		result.insert(QString::fromUtf8("Филипп"), u"Philip"_q);
+		result.insert(QString::fromUtf8("филипп"), u"philip"_q);
+		result.insert(QString::fromUtf8("Пётр"), u"Petr"_q);
+		result.insert(QString::fromUtf8("пётр"), u"petr"_q);
+		result.insert(QString::fromUtf8("Гай"), u"Gai"_q);
+		result.insert(QString::fromUtf8("гай"), u"gai"_q);
+		result.insert(QString::fromUtf8("Ильин"), u"Ilyin"_q);
+		result.insert(QString::fromUtf8("ильин"), u"ilyin"_q);
+		return result;
+	}();
+	return table;
+}
+
+[[nodiscard]] const QHash<QChar, QString> &FastLetterRusEng() {
+	static const auto table = [] {
+		auto result = QHash<QChar, QString>();
+		result.insert(QString::fromUtf8("А").at(0), u"A"_q);
+		result.insert(QString::fromUtf8("Б").at(0), u"B"_q);
+		result.insert(QString::fromUtf8("В").at(0), u"V"_q);
+		result.insert(QString::fromUtf8("Г").at(0), u"G"_q);
+		result.insert(QString::fromUtf8("Ґ").at(0), u"G"_q);
+		result.insert(QString::fromUtf8("Д").at(0), u"D"_q);
+		result.insert(QString::fromUtf8("Е").at(0), u"E"_q);
+		result.insert(QString::fromUtf8("Є").at(0), u"Ye"_q);
+		result.insert(QString::fromUtf8("Ё").at(0), u"Yo"_q);
+		result.insert(QString::fromUtf8("Ж").at(0), u"Zh"_q);
+		result.insert(QString::fromUtf8("З").at(0), u"Z"_q);
+		result.insert(QString::fromUtf8("И").at(0), u"I"_q);
+		result.insert(QString::fromUtf8("Ї").at(0), u"Yi"_q);
+		result.insert(QString::fromUtf8("І").at(0), u"I"_q);
+		result.insert(QString::fromUtf8("Й").at(0), u"J"_q);
+		result.insert(QString::fromUtf8("К").at(0), u"K"_q);
+		result.insert(QString::fromUtf8("Л").at(0), u"L"_q);
+		result.insert(QString::fromUtf8("М").at(0), u"M"_q);
+		result.insert(QString::fromUtf8("Н").at(0), u"N"_q);
+		result.insert(QString::fromUtf8("О").at(0), u"O"_q);
+		result.insert(QString::fromUtf8("П").at(0), u"P"_q);
+		result.insert(QString::fromUtf8("Р").at(0), u"R"_q);
+		result.insert(QString::fromUtf8("С").at(0), u"S"_q);
+		result.insert(QString::fromUtf8("Т").at(0), u"T"_q);
+		result.insert(QString::fromUtf8("У").at(0), u"U"_q);
+		result.insert(QString::fromUtf8("Ў").at(0), u"W"_q);
+		result.insert(QString::fromUtf8("Ф").at(0), u"F"_q);
+		result.insert(QString::fromUtf8("Х").at(0), u"Kh"_q);
+		result.insert(QString::fromUtf8("Ц").at(0), u"Ts"_q);
+		result.insert(QString::fromUtf8("Ч").at(0), u"Ch"_q);
+		result.insert(QString::fromUtf8("Ш").at(0), u"Sh"_q);
+		result.insert(QString::fromUtf8("Щ").at(0), u"Sch"_q);
+		result.insert(QString::fromUtf8("Э").at(0), u"E"_q);
+		result.insert(QString::fromUtf8("Ю").at(0), u"Yu"_q);
+		result.insert(QString::fromUtf8("Я").at(0), u"Ya"_q);
+		result.insert(QString::fromUtf8("Ў").at(0), u"W"_q);
+		result.insert(QString::fromUtf8("а").at(0), u"a"_q);
+		result.insert(QString::fromUtf8("б").at(0), u"b"_q);
+		result.insert(QString::fromUtf8("в").at(0), u"v"_q);
+		result.insert(QString::fromUtf8("г").at(0), u"g"_q);
+		result.insert(QString::fromUtf8("ґ").at(0), u"g"_q);
+		result.insert(QString::fromUtf8("д").at(0), u"d"_q);
+		result.insert(QString::fromUtf8("е").at(0), u"e"_q);
+		result.insert(QString::fromUtf8("є").at(0), u"ye"_q);
+		result.insert(QString::fromUtf8("ё").at(0), u"yo"_q);
+		result.insert(QString::fromUtf8("ж").at(0), u"zh"_q);
+		result.insert(QString::fromUtf8("з").at(0), u"z"_q);
+		result.insert(QString::fromUtf8("й").at(0), u"y"_q);
+		result.insert(QString::fromUtf8("ї").at(0), u"yi"_q);
+		result.insert(QString::fromUtf8("і").at(0), u"i"_q);
+		result.insert(QString::fromUtf8("л").at(0), u"l"_q);
+		result.insert(QString::fromUtf8("м").at(0), u"m"_q);
+		result.insert(QString::fromUtf8("н").at(0), u"n"_q);
+		result.insert(QString::fromUtf8("о").at(0), u"o"_q);
+		result.insert(QString::fromUtf8("п").at(0), u"p"_q);
+		result.insert(QString::fromUtf8("р").at(0), u"r"_q);
+		result.insert(QString::fromUtf8("с").at(0), u"s"_q);
+		result.insert(QString::fromUtf8("т").at(0), u"t"_q);
+		result.insert(QString::fromUtf8("у").at(0), u"u"_q);
+		result.insert(QString::fromUtf8("ў").at(0), u"w"_q);
+		result.insert(QString::fromUtf8("ф").at(0), u"f"_q);
+		result.insert(QString::fromUtf8("х").at(0), u"kh"_q);
+		result.insert(QString::fromUtf8("ц").at(0), u"ts"_q);
+		result.insert(QString::fromUtf8("ч").at(0), u"ch"_q);
+		result.insert(QString::fromUtf8("ш").at(0), u"sh"_q);
+		result.insert(QString::fromUtf8("щ").at(0), u"sch"_q);
+		result.insert(QString::fromUtf8("ъ").at(0), QString());
+		result.insert(QString::fromUtf8("э").at(0), u"e"_q);
+		result.insert(QString::fromUtf8("ю").at(0), u"yu"_q);
+		result.insert(QString::fromUtf8("я").at(0), u"ya"_q);
+		result.insert(QString::fromUtf8("ў").at(0), u"w"_q);
+		result.insert(QString::fromUtf8("Ы").at(0), u"Y"_q);
+		result.insert(QString::fromUtf8("и").at(0), u"i"_q);
+		result.insert(QString::fromUtf8("к").at(0), u"k"_q);
+		result.insert(QString::fromUtf8("ы").at(0), u"y"_q);
+		result.insert(QString::fromUtf8("ь").at(0), QString());
+		return result;
+	}();
+	return table;
+}
+
+[[nodiscard]] const QMap<uint32, QString> &FastDoubleLetterRusEng() {
+	static const auto table = [] {
+		auto result = QMap<uint32, QString>();
+		result.insert((QString::fromUtf8("Ы").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"Y"_q);
+		result.insert((QString::fromUtf8("и").at(0).unicode() << 16) | QString::fromUtf8("я").at(0).unicode(), u"ia"_q);
+		result.insert((QString::fromUtf8("и").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"y"_q);
+		result.insert((QString::fromUtf8("к").at(0).unicode() << 16) | QString::fromUtf8("с").at(0).unicode(), u"x"_q);
+		result.insert((QString::fromUtf8("ы").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"y"_q);
+		result.insert((QString::fromUtf8("ь").at(0).unicode() << 16) | QString::fromUtf8("е").at(0).unicode(), u"ye"_q);
+		return result;
+	}();
+	return table;
+}
+
+[[nodiscard]] const QHash<QChar, QChar> &FastRusKeyboardSwitch() {
+	static const auto table = [] {
+		auto result = QHash<QChar, QChar>();
+		const auto engAlphabet = QString("qwertyuiop[]asdfghjkl;'zxcvbnm,.");
+		const auto engAlphabetUpper = engAlphabet.toUpper();
+		QString rusAlphabet = "йцукенгшщзхъфывапролджэячсмитьбю";
+		QString rusAlphabetUpper = rusAlphabet.toUpper();
+		for (int i = 0; i < rusAlphabet.size(); ++i) {
+			result.insert(engAlphabetUpper[i], rusAlphabetUpper[i]);
+			result.insert(engAlphabet[i], rusAlphabet[i]);
+			result.insert(rusAlphabetUpper[i], engAlphabetUpper[i]);
+			result.insert(rusAlphabet[i], engAlphabet[i]);
+		}
+		return result;
+	}();
+	return table;
+}
+
+[[nodiscard]] const QHash<QChar, QChar> &FastUkrKeyboardSwitch() {
+	static const auto table = [] {
+		auto result = QHash<QChar, QChar>();
+		const auto engAlphabet = QString("qwertyuiop[]asdfghjkl;'zxcvbnm,.");
+		const auto engAlphabetUpper = engAlphabet.toUpper();
+		QString ukrAlphabet = "йцукенгшщзхїфівапролджєячсмитьбю";
+		QString ukrAlphabetUpper = ukrAlphabet.toUpper();
+		for (int i = 0; i < ukrAlphabet.size(); ++i) {
+			result.insert(engAlphabetUpper[i], ukrAlphabetUpper[i]);
+			result.insert(engAlphabet[i], ukrAlphabet[i]);
+			result.insert(ukrAlphabetUpper[i], engAlphabetUpper[i]);
+			result.insert(ukrAlphabet[i], engAlphabet[i]);
+		}
+		return result;
+	}();
+	return table;
 }
 
+} // namespace
+
 QString translitLetterRusEng(QChar letter, QChar next, int32 &toSkip) {
-	if (fastDoubleLetterRusEng.isEmpty()) {
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("Ы").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"Y"_q);
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("и").at(0).unicode() << 16) | QString::fromUtf8("я").at(0).unicode(), u"ia"_q);
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("и").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"y"_q);
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("к").at(0).unicode() << 16) | QString::fromUtf8("с").at(0).unicode(), u"x"_q);
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("ы").at(0).unicode() << 16) | QString::fromUtf8("й").at(0).unicode(), u"y"_q);
-		fastDoubleLetterRusEng.insert((QString::fromUtf8("ь").at(0).unicode() << 16) | QString::fromUtf8("е").at(0).unicode(), u"ye"_q);
-	}
+	const auto &fastDoubleLetterRusEng = FastDoubleLetterRusEng();
 	QMap<uint32, QString>::const_iterator i = fastDoubleLetterRusEng.constFind((letter.unicode() << 16) | next.unicode());
 	if (i != fastDoubleLetterRusEng.cend()) {
 		toSkip = 2;
@@ -352,84 +495,7 @@ QString translitLetterRusEng(QChar letter, QChar next, int32 &toSkip) {
 	}
 
 	toSkip = 1;
-	if (fastLetterRusEng.isEmpty()) {
-		fastLetterRusEng.insert(QString::fromUtf8("А").at(0), u"A"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Б").at(0), u"B"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("В").at(0), u"V"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Г").at(0), u"G"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ґ").at(0), u"G"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Д").at(0), u"D"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Е").at(0), u"E"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Є").at(0), u"Ye"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ё").at(0), u"Yo"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ж").at(0), u"Zh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("З").at(0), u"Z"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("И").at(0), u"I"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ї").at(0), u"Yi"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("І").at(0), u"I"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Й").at(0), u"J"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("К").at(0), u"K"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Л").at(0), u"L"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("М").at(0), u"M"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Н").at(0), u"N"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("О").at(0), u"O"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("П").at(0), u"P"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Р").at(0), u"R"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("С").at(0), u"S"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Т").at(0), u"T"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("У").at(0), u"U"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ў").at(0), u"W"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ф").at(0), u"F"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Х").at(0), u"Kh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ц").at(0), u"Ts"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ч").at(0), u"Ch"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ш").at(0), u"Sh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Щ").at(0), u"Sch"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Э").at(0), u"E"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ю").at(0), u"Yu"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Я").at(0), u"Ya"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ў").at(0), u"W"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("а").at(0), u"a"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("б").at(0), u"b"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("в").at(0), u"v"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("г").at(0), u"g"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ґ").at(0), u"g"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("д").at(0), u"d"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("е").at(0), u"e"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("є").at(0), u"ye"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ё").at(0), u"yo"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ж").at(0), u"zh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("з").at(0), u"z"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("й").at(0), u"y"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ї").at(0), u"yi"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("і").at(0), u"i"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("л").at(0), u"l"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("м").at(0), u"m"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("н").at(0), u"n"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("о").at(0), u"o"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("п").at(0), u"p"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("р").at(0), u"r"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("с").at(0), u"s"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("т").at(0), u"t"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("у").at(0), u"u"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ў").at(0), u"w"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ф").at(0), u"f"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("х").at(0), u"kh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ц").at(0), u"ts"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ч").at(0), u"ch"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ш").at(0), u"sh"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("щ").at(0), u"sch"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ъ").at(0), QString());
-		fastLetterRusEng.insert(QString::fromUtf8("э").at(0), u"e"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ю").at(0), u"yu"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("я").at(0), u"ya"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ў").at(0), u"w"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("Ы").at(0), u"Y"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("и").at(0), u"i"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("к").at(0), u"k"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ы").at(0), u"y"_q);
-		fastLetterRusEng.insert(QString::fromUtf8("ь").at(0), QString());
-	}
+	const auto &fastLetterRusEng = FastLetterRusEng();
 	QHash<QChar, QString>::const_iterator j = fastLetterRusEng.constFind(letter);
 	if (j != fastLetterRusEng.cend()) {
 		return j.value();
@@ -438,18 +504,7 @@ QString translitLetterRusEng(QChar letter, QChar next, int32 &toSkip) {
 }
 
 QString translitRusEng(const QString &rus) {
-	if (fastRusEng.isEmpty()) {
-		fastRusEng.insert(QString::fromUtf8("Александр"), u"Alexander"_q);
-		fastRusEng.insert(QString::fromUtf8("александр"), u"alexander"_q);
-		fastRusEng.insert(QString::fromUtf8("Филипп"), u"Philip"_q);
-		fastRusEng.insert(QString::fromUtf8("филипп"), u"philip"_q);
-		fastRusEng.insert(QString::fromUtf8("Пётр"), u"Petr"_q);
-		fastRusEng.insert(QString::fromUtf8("пётр"), u"petr"_q);
-		fastRusEng.insert(QString::fromUtf8("Гай"), u"Gai"_q);
-		fastRusEng.insert(QString::fromUtf8("гай"), u"gai"_q);
-		fastRusEng.insert(QString::fromUtf8("Ильин"), u"Ilyin"_q);
-		fastRusEng.insert(QString::fromUtf8("ильин"), u"ilyin"_q);
-	}
+	const auto &fastRusEng = FastRusEng();
 	QMap<QString, QString>::const_iterator i = fastRusEng.constFind(rus);
 	if (i != fastRusEng.cend()) {
 		return i.value();
@@ -465,33 +520,7 @@ QString translitRusEng(const QString &rus) {
 	return result;
 }
 
-QString engAlphabet = "qwertyuiop[]asdfghjkl;'zxcvbnm,.";
-QString engAlphabetUpper = engAlphabet.toUpper();
-
-void initializeKeyboardSwitch() {
-	if (fastRusKeyboardSwitch.isEmpty()) {
-		QString rusAlphabet = "йцукенгшщзхъфывапролджэячсмитьбю";
-		QString rusAlphabetUpper = rusAlphabet.toUpper();
-		for (int i = 0; i < rusAlphabet.size(); ++i) {
-			fastRusKeyboardSwitch.insert(engAlphabetUpper[i], rusAlphabetUpper[i]);
-			fastRusKeyboardSwitch.insert(engAlphabet[i], rusAlphabet[i]);
-			fastRusKeyboardSwitch.insert(rusAlphabetUpper[i], engAlphabetUpper[i]);
-			fastRusKeyboardSwitch.insert(rusAlphabet[i], engAlphabet[i]);
-		}
-	}
-	if (fastUkrKeyboardSwitch.isEmpty()) {
-		QString ukrAlphabet = "йцукенгшщзхїфівапролджєячсмитьбю";
-		QString ukrAlphabetUpper = ukrAlphabet.toUpper();
-		for (int i = 0; i < ukrAlphabet.size(); ++i) {
-			fastUkrKeyboardSwitch.insert(engAlphabetUpper[i], ukrAlphabetUpper[i]);
-			fastUkrKeyboardSwitch.insert(engAlphabet[i], ukrAlphabet[i]);
-			fastUkrKeyboardSwitch.insert(ukrAlphabetUpper[i], engAlphabetUpper[i]);
-			fastUkrKeyboardSwitch.insert(ukrAlphabet[i], engAlphabet[i]);
-		}
-	}
-}
-
-QString switchKeyboardLayout(const QString& from, QHash<QChar, QChar>& keyboardSwitch) {
+QString switchKeyboardLayout(const QString& from, const QHash<QChar, QChar>& keyboardSwitch) {
 	QString result;
 	result.reserve(from.size());
 	for (QString::const_iterator i = from.cbegin(), e = from.cend(); i != e; ++i) {
@@ -506,8 +535,7 @@ QString switchKeyboardLayout(const QString& from, QHash<QChar, QChar>& keyboardS
 }
 
 QString rusKeyboardLayoutSwitch(const QString& from) {
-	initializeKeyboardSwitch();
-	QString rus = switchKeyboardLayout(from, fastRusKeyboardSwitch);
-	QString ukr = switchKeyboardLayout(from, fastUkrKeyboardSwitch);
+	QString rus = switchKeyboardLayout(from, FastRusKeyboardSwitch());
+	QString ukr = switchKeyboardLayout(from, FastUkrKeyboardSwitch());
 	return rus == ukr ? rus : rus + ' ' + ukr;
 }
@@ -278,8 +278,10 @@ const GroupCallParticipant *GroupCall::participantByPeer(
 
 GroupCallParticipant *GroupCall::findParticipant(
 		not_null<PeerData*> peer) {
-	const auto i = ranges::find(_participants, peer, &Participant::peer);
-	return (i != end(_participants)) ? &*i : nullptr;
+	const auto i = _participantIndexByPeer.find(peer);
+	return (i != end(_participantIndexByPeer))
+		? &_participants[i->second]
+		: nullptr;
 }
 
 const GroupCallParticipant *GroupCall::participantByEndpoint(
@@ -843,11 +845,8 @@ void GroupCall::applyLocalVolume(
 		not_null<PeerData*> participantPeer,
 		bool mute,
 		std::optional<int> volume) {
-	const auto i = ranges::find(
-		_participants,
-		participantPeer,
-		&Participant::peer);
-	Assert(i != end(_participants));
+	const auto i = findParticipant(participantPeer);
+	Assert(i != nullptr);
 	const auto was = std::make_optional(*i);
 	auto now = *i;
 	if (now.canBeMutedForAllUsers) {
@@ -869,12 +868,9 @@ void GroupCall::applyParticipant(
 	const auto participantPeerId = peerFromSender(data.vparticipant_id());
 	const auto participantPeer = _peer->owner().peer(
 		participantPeerId);
-	const auto i = ranges::find(
-		_participants,
-		participantPeer,
-		&Participant::peer);
+	const auto i = findParticipant(participantPeer);
 	if (data.vorder().v.isEmpty()) {
-		if (i != end(_participants)) {
+		if (i) {
 			auto update = ParticipantUpdate{
 				.was = *i,
 			};
@@ -885,7 +881,7 @@ void GroupCall::applyParticipant(
 				GetAdditionalAudioSsrc(i->videoParams));
 #endif
 			_speakingByActiveFinishes.remove(participantPeer);
-			_participants.erase(i);
+			removeParticipant(participantPeer);
 			if (sliceSource != ApplySliceSource::FullReloaded) {
 				_participantUpdates.fire(std::move(update));
 			}
@@ -896,17 +892,13 @@ void GroupCall::applyParticipant(
 		return;
 	}
 	participantPeer->setAbout(data.vbio().v);
-	const auto was = (i != end(_participants))
-		? std::make_optional(*i)
-		: std::nullopt;
+	const auto was = i ? std::make_optional(*i) : std::nullopt;
 	const auto canSelfUnmute = data.vcan_unmute_self().v;
 	const auto canBeSpeaking = !data.vis_muted_for_all_users().v
 		|| data.vcan_unmute_self().v;
 	const auto localUpdate = (sliceSource
 		== ApplySliceSource::UpdateConstructed);
-	const auto existingVideoParams = (i != end(_participants))
-		? i->videoParams
-		: nullptr;
+	const auto existingVideoParams = i ? i->videoParams : nullptr;
 	auto videoParams = localUpdate
 		? existingVideoParams
 		: Calls::ParseVideoParams(
@@ -940,7 +932,7 @@ void GroupCall::applyParticipant(
 			data.vcan_be_unmuted_for_current_user().v,
 		.order = data.vorder().v,
 	};
-	if (i == end(_participants)) {
+	if (!i) {
 		if (value.ssrc) {
 			_participantPeerByAudioSsrc.emplace(
 				value.ssrc,
@@ -955,6 +947,9 @@ void GroupCall::applyParticipant(
 				additional,
 				participantPeer);
 		}
+		_participantIndexByPeer.emplace(
+			participantPeer,
+			int(_participants.size()));
 		_participants.push_back(value);
 		if (const auto user = participantPeer->asUser()) {
 			_peer->owner().unregisterInvitedToCallUser(_id, user);
@@ -998,6 +993,21 @@ void GroupCall::applyParticipant(
 	}
 }
 
+void GroupCall::removeParticipant(not_null<PeerData*> participantPeer) {
+	const auto i = _participantIndexByPeer.find(participantPeer);
+	if (i == end(_participantIndexByPeer)) {
+		return;
+	}
+	const auto index = i->second;
+	_participantIndexByPeer.erase(i);
+	_participants.erase(begin(_participants) + index);
+
+	// Keep the server order of the rest, only reindex the shifted ones.
+	for (auto j = index, count = int(_participants.size()); j != count; ++j) {
+		_participantIndexByPeer[_participants[j].peer] = j;
+	}
+}
+
 void GroupCall::applyLastSpoke(
 		uint32 ssrc,
 		LastSpokeTimes when,
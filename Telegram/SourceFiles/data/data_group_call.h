@@ -266,6 +266,7 @@ private:
 	void finishParticipantsSliceRequest();
 #endif
 	[[nodiscard]] Participant *findParticipant(not_null<PeerData*> peer);
+	void removeParticipant(not_null<PeerData*> participantPeer);
 
 	const CallId _id = 0;
 #if 0 // goodToRemove
@@ -288,7 +289,10 @@ private:
 #endif
 
 	std::vector<Participant> _participants;
-	base::flat_map<uint32, not_null<PeerData*>> _participantPeerByAudioSsrc;
+	std::unordered_map<not_null<PeerData*>, int> _participantIndexByPeer;
+	std::unordered_map<
+		uint32,
+		not_null<PeerData*>> _participantPeerByAudioSsrc;
 	base::flat_map<not_null<PeerData*>, crl::time> _speakingByActiveFinishes;
 	base::Timer _speakingByActiveFinishTimer;
 	QString _nextOffset;
@@ -75,6 +75,28 @@ uint8 DecideColorIndex(PeerId peerId) {
 	return Ui::DecideColorIndex(peerId.value & PeerId::kChatTypeMask);
 }
 
+NameWords ComputeNameWords(const QString &source) {
+	auto toIndexList = source.split(QChar(0), Qt::SkipEmptyParts);
+	for (auto &value : toIndexList) {
+		value = TextUtilities::RemoveAccents(value);
+	}
+	const auto appendTranslit = !toIndexList.isEmpty()
+		&& cRussianLetters().match(toIndexList.front()).hasMatch();
+	if (appendTranslit) {
+		toIndexList.push_back(translitRusEng(toIndexList.front()));
+	}
+	auto toIndex = toIndexList.join(' ');
+	toIndex += ' ' + rusKeyboardLayoutSwitch(toIndex);
+
+	auto result = NameWords();
+	const auto namesList = TextUtilities::PrepareSearchWords(toIndex);
+	for (const auto &name : namesList) {
+		result.words.insert(name);
+		result.firstLetters.insert(name[0]);
+	}
+	return result;
+}
+
 PeerId FakePeerIdForJustName(const QString &name) {
 	constexpr auto kShift = (0xFEULL << 32);
 	const auto base = name.isEmpty()
@@ -372,9 +394,11 @@ void PeerData::updateNameDelayed(
 			flags |= UpdateFlag::Username;
 		}
 	}
-	fillNames();
-	if (nameUpdated) {
-		session().changes().nameUpdated(this, std::move(oldFirstLetters));
+	if (!_owner->deferNameWords(this, nameUpdated)) {
+		fillNames();
+		if (nameUpdated) {
+			session().changes().nameUpdated(this, std::move(oldFirstLetters));
+		}
 	}
 	if (flags) {
 		session().changes().peerUpdated(this, flags);
@@ -1089,21 +1113,18 @@ bool PeerData::changeColor(
 #endif
 
 void PeerData::fillNames() {
-	_nameWords.clear();
-	_nameFirstLetters.clear();
+	setNameWords(Data::ComputeNameWords(nameWordsSource()));
+}
+
+QString PeerData::nameWordsSource() const {
 	auto toIndexList = QStringList();
 	auto appendToIndex = [&](const QString &value) {
 		if (!value.isEmpty()) {
-			toIndexList.push_back(TextUtilities::RemoveAccents(value));
+			toIndexList.push_back(value);
 		}
 	};
 
 	appendToIndex(name());
-	const auto appendTranslit = !toIndexList.isEmpty()
-		&& cRussianLetters().match(toIndexList.front()).hasMatch();
-	if (appendTranslit) {
-		appendToIndex(translitRusEng(toIndexList.front()));
-	}
 	if (const auto user = asUser()) {
 		if (user->nameOrPhone != name()) {
 			appendToIndex(user->nameOrPhone);
@@ -1134,14 +1155,12 @@ void PeerData::fillNames() {
 	} else if (const auto channel = asChannel()) {
 		appendToIndex(channel->username());
 	}
-	auto toIndex = toIndexList.join(' ');
-	toIndex += ' ' + rusKeyboardLayoutSwitch(toIndex);
+	return toIndexList.join(QChar(0));
+}
 
-	const auto namesList = TextUtilities::PrepareSearchWords(toIndex);
-	for (const auto &name : namesList) {
-		_nameWords.insert(name);
-		_nameFirstLetters.insert(name[0]);
-	}
+void PeerData::setNameWords(Data::NameWords &&words) {
+	_nameWords = std::move(words.words);
+	_nameFirstLetters = std::move(words.firstLetters);
 }
 
 PeerData::~PeerData() = default;
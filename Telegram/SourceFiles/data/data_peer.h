@@ -57,6 +57,14 @@ class WallPaper;
 
 [[nodiscard]] uint8 DecideColorIndex(PeerId peerId);
 
+struct NameWords {
+	base::flat_set<QString> words;
+	base::flat_set<QChar> firstLetters;
+};
+
+// Thread safe, heavy part of the peer name indexing.
+[[nodiscard]] NameWords ComputeNameWords(const QString &source);
+
 // Must be used only for PeerColor-s.
 [[nodiscard]] PeerId FakePeerIdForJustName(const QString &name);
 
@@ -351,6 +359,10 @@ public:
 		return _nameFirstLetters;
 	}
 
+	// Used by Data::Session to index names of many peers on a worker thread.
+	[[nodiscard]] QString nameWordsSource() const;
+	void setNameWords(Data::NameWords &&words);
+
 	void setPhotoFull(const Tdb::TLchatPhoto &photo);
 
 	void clearPhoto();
@@ -79,6 +79,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/random.h"
 #include "spellcheck/spellcheck_highlight_syntax.h"
 
+#include "tdb/tdb_account.h"
 #include "tdb/tdb_tl_scheme.h"
 #include "history/history_unread_things.h"
 #include "main/session/send_as_peers.h"
@@ -311,6 +312,16 @@ Session::Session(not_null<Main::Session*> session)
 
 	subscribeForTopicRepliesLists();
 
+	// Names of the peers updated in one batch are indexed together.
+	_session->tdb().updateBatchActive(
+	) | rpl::start_with_next([=](bool active) {
+		if (active) {
+			_updateBatchLifetime.add([guard = indexNamesInBulk()] {});
+		} else {
+			_updateBatchLifetime.destroy();
+		}
+	}, _lifetime);
+
 	crl::on_main(_session, [=] {
 		AmPremiumValue(
 			_session
@@ -1594,7 +1605,62 @@ PeerData *Session::processChats(const MTPVector<MTPChat> &data) {
 }
 #endif
 
+bool Session::deferNameWords(not_null<PeerData*> peer, bool nameUpdated) {
+	// A peer renamed while its words are computed waits for the next pass,
+	// so that the older result is not applied over the newer one.
+	if (!_deferNameWordsLevel && !_computingNameWords.contains(peer)) {
+		return false;
+	}
+	auto &updated = _deferredNameWords[peer];
+	updated = updated || nameUpdated;
+	return true;
+}
+
+void Session::computeDeferredNameWords() {
+	if (_deferNameWordsLevel
+		|| !_computingNameWords.empty()
+		|| _deferredNameWords.empty()) {
+		return;
+	}
+	_computingNameWords = base::take(_deferredNameWords);
+	auto sources = std::vector<QString>();
+	sources.reserve(_computingNameWords.size());
+	for (const auto &[peer, nameUpdated] : _computingNameWords) {
+		sources.push_back(peer->nameWordsSource());
+	}
+	const auto weak = base::make_weak(_session);
+	crl::async([=, sources = std::move(sources)] {
+		auto words = std::vector<NameWords>();
+		words.reserve(sources.size());
+		for (const auto &source : sources) {
+			words.push_back(ComputeNameWords(source));
+		}
+		crl::on_main(weak, [=, words = std::move(words)]() mutable {
+			applyComputedNameWords(std::move(words));
+		});
+	});
+}
+
+void Session::applyComputedNameWords(std::vector<NameWords> &&words) {
+	const auto computed = base::take(_computingNameWords);
+	Assert(computed.size() == words.size());
+
+	auto result = begin(words);
+	for (const auto &[peer, nameUpdated] : computed) {
+		auto oldFirstLetters = peer->nameFirstLetters();
+		const auto changed = (oldFirstLetters != result->firstLetters);
+		peer->setNameWords(std::move(*result++));
+
+		// Rows could be added to the indexed lists while letters were stale.
+		if (nameUpdated || changed) {
+			session().changes().nameUpdated(peer, std::move(oldFirstLetters));
+		}
+	}
+	computeDeferredNameWords();
+}
+
 PeerData *Session::processPeers(const std::vector<TLchat> &data) {
+	const auto guard = indexNamesInBulk();
 	auto result = (PeerData*)nullptr;
 	for (const auto &dialog : data) {
 		result = processPeer(dialog);
@@ -1603,6 +1669,7 @@ PeerData *Session::processPeers(const std::vector<TLchat> &data) {
 }
 
 UserData *Session::processUsers(const std::vector<TLuser> &data) {
+	const auto guard = indexNamesInBulk();
 	auto result = (UserData*)nullptr;
 	for (const auto &user : data) {
 		result = processUser(user);
@@ -1611,6 +1678,7 @@ UserData *Session::processUsers(const std::vector<TLuser> &data) {
 }
 
 ChatData *Session::processChats(const std::vector<TLbasicGroup> &data) {
+	const auto guard = indexNamesInBulk();
 	auto result = (ChatData*)nullptr;
 	for (const auto &chat : data) {
 		result = processChat(chat);
@@ -1620,6 +1688,7 @@ ChatData *Session::processChats(const std::vector<TLbasicGroup> &data) {
 
 ChannelData *Session::processChannels(
 		const std::vector<TLsupergroup> &data) {
+	const auto guard = indexNamesInBulk();
 	auto result = (ChannelData*)nullptr;
 	for (const auto &channel : data) {
 		result = processChannel(channel);
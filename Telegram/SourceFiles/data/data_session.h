@@ -105,6 +105,7 @@ class Chatbots;
 class BusinessInfo;
 struct ReactionId;
 struct UnavailableReason;
+struct NameWords;
 
 struct PhotoLocalData;
 struct DocumentLocalData;
@@ -273,6 +274,22 @@ public:
 	PeerData *processChats(const MTPVector<MTPChat> &data);
 #endif
 
+	// Name words of peers renamed while the guard is alive are computed
+	// together on a worker thread when it is destroyed. Until then their
+	// nameWords() and nameFirstLetters() are stale, even in peerUpdated()
+	// handlers for the Name flag, nameUpdated() is fired once they are set.
+	[[nodiscard]] auto indexNamesInBulk() {
+		++_deferNameWordsLevel;
+		return gsl::finally([=] {
+			if (!--_deferNameWordsLevel) {
+				computeDeferredNameWords();
+			}
+		});
+	}
+	[[nodiscard]] bool deferNameWords(
+		not_null<PeerData*> peer,
+		bool nameUpdated);
+
 	// Returns last user, if there were any.
 	PeerData *processPeers(const std::vector<Tdb::TLchat> &data);
 	UserData *processUsers(const std::vector<Tdb::TLuser> &data);
@@ -961,6 +978,9 @@ private:
 
 	void suggestStartExport();
 
+	void computeDeferredNameWords();
+	void applyComputedNameWords(std::vector<NameWords> &&words);
+
 	void setupMigrationViewer();
 	void setupChannelLeavingViewer();
 	void setupPeerNameViewer();
@@ -1308,6 +1328,11 @@ private:
 
 	MsgId _nonHistoryEntryId = ShortcutMaxMsgId;
 
+	int _deferNameWordsLevel = 0;
+	base::flat_map<not_null<PeerData*>, bool> _deferredNameWords;
+	base::flat_map<not_null<PeerData*>, bool> _computingNameWords;
+	rpl::lifetime _updateBatchLifetime;
+
 	rpl::lifetime _lifetime;
 
 };
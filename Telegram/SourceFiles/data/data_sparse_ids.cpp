@@ -187,11 +187,46 @@ bool SparseIdsSliceBuilder::applyUpdate(
 	auto skippedAfter = (update.range.till == ServerMaxMsgId)
 		? 0
 		: std::optional<int> {};
+	if (!needMergeMessages || !_key) {
+		mergeSliceData(
+			update.count,
+			needMergeMessages
+				? *update.messages
+				: base::flat_set<MsgId> {},
+			skippedBefore,
+			skippedAfter);
+		return true;
+	}
+
+	// Shared media slices may hold hundreds of thousands of ids, while
+	// sliceToLimits() keeps only the limits around the key. Merge just
+	// that window, extended to cover the ids we already have, so that
+	// the skipped counters come out the same as with the whole slice.
+	const auto &all = *update.messages;
+	const auto around = ranges::lower_bound(all, _key);
+	auto from = (around - all.begin() > _limitBefore)
+		? (around - _limitBefore)
+		: all.begin();
+	auto till = (all.end() - around > _limitAfter + 1)
+		? (around + _limitAfter + 1)
+		: all.end();
+	if (!_ids.empty()) {
+		from = std::min(from, ranges::lower_bound(all, _ids.front()));
+		till = std::max(till, ranges::upper_bound(all, _ids.back()));
+	}
+	if (from == till) {
+		mergeSliceData(update.count, all, skippedBefore, skippedAfter);
+		return true;
+	}
+	if (skippedBefore) {
+		*skippedBefore = int(from - all.begin());
+	}
+	if (skippedAfter) {
+		*skippedAfter = int(all.end() - till);
+	}
 	mergeSliceData(
 		update.count,
-		needMergeMessages
-			? *update.messages
-			: base::flat_set<MsgId> {},
+		base::flat_set<MsgId>(from, till),
 		skippedBefore,
 		skippedAfter);
 	return true;
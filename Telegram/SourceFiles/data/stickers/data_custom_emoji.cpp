@@ -46,6 +46,7 @@ namespace {
 using namespace Tdb;
 
 constexpr auto kMaxPerRequest = 100;
+constexpr auto kRepaintsSlack = crl::time(8);
 #if 0 // inject-to-on_main
 constexpr auto kUnsubscribeUpdatesDelay = 3 * crl::time(1000);
 #endif
@@ -919,6 +920,16 @@ void CustomEmojiManager::scheduleRepaintTimer() {
 				next = bunch.when;
 			}
 		}
+
+		// Animations with different frame durations get due at close
+		// moments, wait a bit to repaint them all in a single pass.
+		auto latest = next;
+		for (const auto &[duration, bunch] : _repaints) {
+			if (bunch.when > latest && bunch.when <= next + kRepaintsSlack) {
+				latest = bunch.when;
+			}
+		}
+		next = latest;
 		if (next && (!_repaintNext || _repaintNext > next)) {
 			const auto now = crl::now();
 			if (now >= next) {
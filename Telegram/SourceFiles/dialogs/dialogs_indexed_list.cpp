@@ -26,6 +26,7 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 	}
 
 	auto result = RowsByLetter{ _list.addToEnd(key) };
+	indexWords(key);
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
 		auto j = _index.find(ch);
 		if (j == _index.cend()) {
@@ -42,6 +43,7 @@ Row *IndexedList::addByName(Key key) {
 	}
 
 	const auto result = _list.addByName(key);
+	indexWords(key);
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
 		auto j = _index.find(ch);
 		if (j == _index.cend()) {
@@ -126,6 +128,7 @@ void IndexedList::adjustByName(
 
 	const auto mainRow = _list.adjustByName(key);
 	if (!mainRow) return;
+	indexWords(key);
 
 	auto toRemove = oldLetters;
 	auto toAdd = base::flat_set<QChar>();
@@ -163,6 +166,7 @@ void IndexedList::adjustNames(
 	const auto key = Dialogs::Key(history);
 	auto mainRow = _list.getRow(key);
 	if (!mainRow) return;
+	indexWords(key);
 
 	auto toRemove = oldLetters;
 	auto toAdd = base::flat_set<QChar>();
@@ -196,6 +200,7 @@ void IndexedList::adjustNames(
 
 void IndexedList::remove(Key key, Row *replacedBy) {
 	if (_list.remove(key, replacedBy)) {
+		unindexWords(key);
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (const auto it = _index.find(ch); it != _index.cend()) {
 				it->second.remove(key, replacedBy);
@@ -207,35 +212,76 @@ void IndexedList::remove(Key key, Row *replacedBy) {
 void IndexedList::clear() {
 	_list.clear();
 	_index.clear();
+	_keysByWord.clear();
+	_wordsByKey.clear();
 }
 
-std::vector<not_null<Row*>> IndexedList::filtered(
-		const QStringList &words) const {
-	const auto minimal = [&]() -> const Dialogs::List* {
-		if (empty()) {
-			return nullptr;
-		}
-		auto result = (const Dialogs::List*)nullptr;
-		for (const auto &word : words) {
-			if (word.isEmpty()) {
-				continue;
-			}
-			const auto found = filtered(word[0]);
-			if (!found || found->empty()) {
-				return nullptr;
-			} else if (!result || result->size() > found->size()) {
-				result = found;
+void IndexedList::nameWordsChanged(Key key) {
+	if (_list.contains(key)) {
+		indexWords(key);
+	}
+}
+
+void IndexedList::indexWords(Key key) {
+	unindexWords(key);
+	const auto &words = key.entry()->chatListNameWords();
+	for (const auto &word : words) {
+		_keysByWord[word].emplace(key);
+	}
+	_wordsByKey.emplace(key, words);
+}
+
+void IndexedList::unindexWords(Key key) {
+	const auto i = _wordsByKey.find(key);
+	if (i == _wordsByKey.end()) {
+		return;
+	}
+	for (const auto &word : i->second) {
+		const auto j = _keysByWord.find(word);
+		if (j != _keysByWord.end()) {
+			j->second.remove(key);
+			if (j->second.empty()) {
+				_keysByWord.erase(j);
 			}
 		}
-		return result;
-	}();
+	}
+	_wordsByKey.erase(i);
+}
+
+std::vector<not_null<Row*>> IndexedList::filtered(
+		const QStringList &words) const {
 	auto result = std::vector<not_null<Row*>>();
-	if (!minimal || minimal->empty()) {
+	if (empty()) {
 		return result;
 	}
-	result.reserve(minimal->size());
-	for (const auto &row : *minimal) {
-		const auto &nameWords = row->entry()->chatListNameWords();
+
+	// The longest query word has the narrowest range of indexed words.
+	auto longest = QString();
+	for (const auto &word : words) {
+		if (word.size() > longest.size()) {
+			longest = word;
+		}
+	}
+	if (longest.isEmpty()) {
+		return result;
+	}
+	auto candidates = std::vector<Key>();
+	const auto from = _keysByWord.lower_bound(longest);
+	for (auto i = from; i != _keysByWord.end(); ++i) {
+		if (!i->first.startsWith(longest)) {
+			break;
+		}
+		candidates.insert(
+			candidates.end(),
+			i->second.begin(),
+			i->second.end());
+	}
+	ranges::sort(candidates);
+	candidates.erase(ranges::unique(candidates), candidates.end());
+
+	result.reserve(candidates.size());
+	for (const auto &key : candidates) {
+		const auto &nameWords = _wordsByKey.find(key)->second;
 		const auto found = [&](const QString &word) {
 			for (const auto &name : nameWords) {
 				if (name.startsWith(word)) {
@@ -246,16 +292,21 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 		};
 		const auto allFound = [&] {
 			for (const auto &word : words) {
-				if (!found(word)) {
+				if (word != longest && !found(word)) {
 					return false;
 				}
 			}
 			return true;
 		}();
 		if (allFound) {
-			result.push_back(row);
+			if (const auto row = _list.getRow(key)) {
+				result.push_back(row);
+			}
 		}
 	}
+	ranges::sort(result, [](not_null<Row*> a, not_null<Row*> b) {
+		return a->index() < b->index();
+	});
 	return result;
 }
 
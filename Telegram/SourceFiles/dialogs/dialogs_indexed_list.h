@@ -39,6 +39,9 @@ public:
 		not_null<PeerData*> peer,
 		const base::flat_set<QChar> &oldChars);
 
+	// For entries that are renamed without a peerNameChanged() call.
+	void nameWordsChanged(Key key);
+
 	void remove(Key key, Row *replacedBy = nullptr);
 	void clear();
 
@@ -83,6 +86,9 @@ public:
 	[[nodiscard]] iterator findByY(int y) { return all().findByY(y); }
 
 private:
+	void indexWords(Key key);
+	void unindexWords(Key key);
+
 	void adjustByName(
 		Key key,
 		const base::flat_set<QChar> &oldChars);
@@ -96,6 +102,10 @@ private:
 	List _list, _empty;
 	base::flat_map<QChar, List> _index;
 
+	// Word prefix index for filtered(words), updated together with _index.
+	std::map<QString, base::flat_set<Key>> _keysByWord;
+	std::map<Key, base::flat_set<QString>> _wordsByKey;
+
 };
 
 } // namespace Dialogs
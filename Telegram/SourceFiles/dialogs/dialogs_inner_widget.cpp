@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_search_tags.h"
 #include "history/view/history_view_chat_preview.h"
 #include "history/view/history_view_context_menu.h"
+#include "history/view/history_view_send_action.h"
 #include "history/history.h"
 #include "history/history_item.h"
 #include "core/application.h"
@@ -88,6 +89,14 @@ namespace {
 constexpr auto kHashtagResultsLimit = 5;
 constexpr auto kStartReorderThreshold = 30;
 constexpr auto kQueryPreviewLimit = 32;
+constexpr auto kRowsCacheTimeout = crl::time(300);
+constexpr auto kRowsCacheLimit = 64;
+
+base::options::toggle OptionCacheChatsListRows({
+	.id = kOptionCacheChatsListRows,
+	.name = "Cache chats list rows while scrolling",
+	.description = "Render each chat row once while the list is scrolled.",
+});
 
 [[nodiscard]] int FixedOnTopDialogsCount(not_null<Dialogs::IndexedList*> list) {
 	auto result = 0;
@@ -171,6 +180,8 @@ constexpr auto kQueryPreviewLimit = 32;
 
 } // namespace
 
+const char kOptionCacheChatsListRows[] = "cache-chats-list-rows";
+
 struct InnerWidget::CollapsedRow {
 	CollapsedRow(Data::Folder *folder) : folder(folder) {
 	}
@@ -217,16 +228,19 @@ InnerWidget::InnerWidget(
 , _narrowWidth(st::defaultDialogRow.padding.left()
 	+ st::defaultDialogRow.photoSize
 	+ st::defaultDialogRow.padding.left())
-, _childListShown(std::move(childListShown)) {
+, _childListShown(std::move(childListShown))
+, _rowsCacheClearTimer([=] { clearRowsCache(); }) {
 	setAttribute(Qt::WA_OpaquePaintEvent, true);
 
 	style::PaletteChanged(
 	) | rpl::start_with_next([=] {
 		_topicJumpCache = nullptr;
+		_rowsCache.clear();
 	}, lifetime());
 
 	session().downloaderTaskFinished(
 	) | rpl::start_with_next([=] {
+		_rowsCache.clear();
 		update();
 	}, lifetime());
 
@@ -682,7 +696,8 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		// We translate painter down, but it'll be cropped below rect.
 		p.fillRect(rect(), context.currentBg);
 	});
-	const auto paintRow = [&](
+	const auto paintRowTo = [&](
+			Painter &q,
 			not_null<Row*> row,
 			bool selected,
 			bool mayBeActive) {
@@ -708,7 +723,41 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		context.topicJumpSelected = selected
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
-		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+		Ui::RowPainter::Paint(q, row, validateVideoUserpic(row), context);
+	};
+	const auto paintRow = [&](
+			not_null<Row*> row,
+			bool selected,
+			bool mayBeActive) {
+		paintRowTo(p, row, selected, mayBeActive);
+	};
+	const auto paintCachedRow = [&](not_null<Row*> row, bool selected) {
+		// Only rows without any hover or animated state are cached.
+		const auto key = row->key();
+		const auto thread = row->thread();
+		if (!_rowsCacheEnabled
+			|| selected
+			|| (key == _menuRow.key)
+			|| (key == _chatPreviewRow.key)
+			|| (key.history() && key.history()->isForum())
+			|| isRowActive(row, activeEntry)
+			|| validateVideoUserpic(row)
+			|| (thread && thread->sendActionPainter()->animating())) {
+			return false;
+		}
+		const auto ratio = style::DevicePixelRatio();
+		const auto size = QSize(fullWidth, row->height()) * ratio;
+		auto &image = _rowsCache[key];
+		if (image.size() != size) {
+			image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+			image.setDevicePixelRatio(ratio);
+			image.fill(Qt::transparent);
+			auto q = Painter(&image);
+			q.setInactive(videoPaused);
+			paintRowTo(q, row, false, true);
+		}
+		p.drawImage(0, 0, image);
+		return true;
 	};
 	if (_state == WidgetState::Default) {
 		const auto collapsedSkip = collapsedRowsOffset();
@@ -751,7 +800,10 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 				if (xadd || yadd) {
 					p.translate(xadd, yadd);
 				}
-				paintRow(row, (row->key() == selected), true);
+				const auto rowSelected = (row->key() == selected);
+				if (!paintCachedRow(row, rowSelected)) {
+					paintRow(row, rowSelected, true);
+				}
 				if (xadd || yadd) {
 					p.translate(-xadd, -yadd);
 				}
@@ -1968,6 +2020,7 @@ void InnerWidget::resizeEvent(QResizeEvent *e) {
 	}
 	resizeEmpty();
 	moveSearchIn();
+	_rowsCache.clear();
 }
 
 void InnerWidget::moveSearchIn() {
@@ -2115,6 +2168,7 @@ void InnerWidget::repaintDialogRow(
 			if (const auto folder = row->folder()) {
 				repaintCollapsedFolderRow(folder);
 			}
+			invalidateCachedRow(row->key());
 			update(0, defaultRowTop(row), width(), row->height());
 		}
 	} else if (_state == WidgetState::Filtered) {
@@ -2196,6 +2250,7 @@ void InnerWidget::updateDialogRow(
 				repaintCollapsedFolderRow(folder);
 			}
 			if (const auto dialog = _shownList->getRow(row.key)) {
+				invalidateCachedRow(row.key);
 				const auto position = dialog->index();
 				auto top = dialogsOffset();
 				if (base::in_range(position, 0, _pinnedRows.size())) {
@@ -2330,6 +2385,7 @@ void InnerWidget::refreshShownList() {
 	if (_shownList != list) {
 		_shownList = list;
 		_shownList->updateHeights(_narrowRatio);
+		_rowsCache.clear();
 	}
 }
 
@@ -2950,8 +3006,12 @@ rpl::producer<> InnerWidget::refreshHashtagsRequests() const {
 void InnerWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	const auto scrolled = (_visibleTop != visibleTop);
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
+	if (scrolled) {
+		updateRowsCacheOnScroll();
+	}
 	preloadRowsData();
 	const auto loadTill = _visibleTop
 		+ PreloadHeightsCount * (_visibleBottom - _visibleTop);
@@ -2967,6 +3027,51 @@ void InnerWidget::visibleTopBottomUpdated(
 	}
 }
 
+void InnerWidget::updateRowsCacheOnScroll() {
+	if (_state != WidgetState::Default
+		|| !OptionCacheChatsListRows.value()) {
+		return;
+	}
+	_rowsCacheEnabled = true;
+	if (_rowsCache.size() > kRowsCacheLimit) {
+		pruneRowsCache();
+	}
+	_rowsCacheClearTimer.callOnce(kRowsCacheTimeout);
+}
+
+void InnerWidget::pruneRowsCache() {
+	const auto skip = dialogsOffset();
+	const auto screen = _visibleBottom - _visibleTop;
+	const auto from = _visibleTop - screen - skip;
+	const auto till = _visibleBottom + screen - skip;
+	for (auto i = _rowsCache.begin(); i != _rowsCache.end();) {
+		const auto row = _shownList->getRow(i->first);
+		if (!row
+			|| (row->top() + row->height() <= from)
+			|| (row->top() >= till)) {
+			i = _rowsCache.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void InnerWidget::clearRowsCache() {
+	_rowsCacheClearTimer.cancel();
+	if (!_rowsCacheEnabled) {
+		return;
+	}
+	_rowsCacheEnabled = false;
+	_rowsCache.clear();
+
+	// Cached rows could skip some animation frames, repaint them live.
+	update();
+}
+
+void InnerWidget::invalidateCachedRow(Key key) {
+	_rowsCache.remove(key);
+}
+
 void InnerWidget::itemRemoved(not_null<const HistoryItem*> item) {
 	int wasCount = _searchResults.size();
 	for (auto i = _searchResults.begin(); i != _searchResults.end();) {
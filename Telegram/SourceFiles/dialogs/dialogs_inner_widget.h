@@ -56,6 +56,8 @@ struct TopicJumpCache;
 
 namespace Dialogs {
 
+extern const char kOptionCacheChatsListRows[];
+
 class Row;
 class FakeRow;
 class IndexedList;
@@ -415,6 +417,11 @@ private:
 	Ui::VideoUserpic *validateVideoUserpic(not_null<Row*> row);
 	Ui::VideoUserpic *validateVideoUserpic(not_null<History*> history);
 
+	void updateRowsCacheOnScroll();
+	void clearRowsCache();
+	void pruneRowsCache();
+	void invalidateCachedRow(Key key);
+
 	Row *shownRowByKey(Key key);
 	void clearSearchResults(bool clearPeerSearchResults = true);
 	void updateSelectedRow(Key key = Key());
@@ -567,6 +574,11 @@ private:
 
 	base::unique_qptr<Ui::PopupMenu> _menu;
 
+	// Rows rendered while the list is scrolling, dropped when it stops.
+	base::flat_map<Key, QImage> _rowsCache;
+	base::Timer _rowsCacheClearTimer;
+	bool _rowsCacheEnabled = false;
+
 };
 
 } // namespace Dialogs
@@ -62,19 +62,21 @@ not_null<Row*> List::addByName(Key key) {
 void List::adjustByName(not_null<Row*> row) {
 	Expects(row->index() >= 0 && row->index() < _rows.size());
 
+	// All rows except this one are sorted, so binary search both sides.
 	const auto &key = row->entry()->chatListNameSortKey();
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return row->entry()->chatListNameSortKey().compare(key) >= 0;
-	});
+	const auto less = [&](Row *row) {
+		return row->entry()->chatListNameSortKey().compare(key) < 0;
+	};
+	const auto lessOrEqual = [&](Row *row) {
+		return row->entry()->chatListNameSortKey().compare(key) <= 0;
+	};
+	const auto before = std::partition_point(i + 1, _rows.end(), less);
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else if (i != _rows.begin()) {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return row->entry()->chatListNameSortKey().compare(key) <= 0;
-		}).base();
+		const auto after = std::partition_point(_rows.begin(), i, lessOrEqual);
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -84,19 +86,24 @@ void List::adjustByName(not_null<Row*> row) {
 void List::adjustByDate(not_null<Row*> row) {
 	Expects(_sortMode == SortMode::Date);
 
+	// All rows except this one are sorted, so binary search both sides.
 	const auto key = row->sortKey(_filterId);
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
-	});
+	const auto greater = [&](Row *row) {
+		return (row->sortKey(_filterId) > key);
+	};
+	const auto greaterOrEqual = [&](Row *row) {
+		return (row->sortKey(_filterId) >= key);
+	};
+	const auto before = std::partition_point(i + 1, _rows.end(), greater);
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return (row->sortKey(_filterId) >= key);
-		}).base();
+		const auto after = std::partition_point(
+			_rows.begin(),
+			i,
+			greaterOrEqual);
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -110,15 +117,14 @@ bool List::updateHeight(Key key, float64 narrowRatio) {
 	}
 	const auto row = i->second.get();
 	const auto index = row->index();
-	auto top = row->top();
 	const auto was = row->height();
 	row->recountHeight(narrowRatio);
-	if (row->height() == was) {
+	const auto delta = row->height() - was;
+	if (!delta) {
 		return false;
 	}
-	for (auto i = _rows.begin() + index, e = _rows.end(); i != e; ++i) {
-		(*i)->_top = top;
-		top += (*i)->height();
+	for (auto i = _rows.begin() + index + 1, e = _rows.end(); i != e; ++i) {
+		(*i)->_top += delta;
 	}
 	return true;
 }
@@ -172,14 +178,13 @@ bool List::remove(Key key, Row *replacedBy) {
 	const auto row = i->second.get();
 	row->entry()->owner().dialogsRowReplaced({ row, replacedBy });
 
-	auto top = row->top();
+	const auto delta = row->height();
 	const auto index = row->index();
 	_rows.erase(_rows.begin() + index);
 	for (auto i = index, count = int(_rows.size()); i != count; ++i) {
 		const auto row = _rows[i];
 		row->_index = i;
-		row->_top = top;
-		top += row->height();
+		row->_top -= delta;
 	}
 	_rowByKey.erase(i);
 	return true;
@@ -42,6 +42,12 @@ MainList::MainList(
 	) | rpl::start_with_next([=](const Data::NameUpdate &update) {
 		_all.peerNameChanged(_filterId, update.peer, update.oldFirstLetters);
 	}, _lifetime);
+
+	session->changes().topicUpdates(
+		Data::TopicUpdate::Flag::Title
+	) | rpl::start_with_next([=](const Data::TopicUpdate &update) {
+		_all.nameWordsChanged(update.topic.get());
+	}, _lifetime);
 }
 
 bool MainList::empty() const {
@@ -19,15 +19,22 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Export {
 namespace Output {
 
-File::File(const QString &path, Stats *stats) : _path(path), _stats(stats) {
+File::File(const QString &path, Stats *stats, int bufferSize)
+: _path(path)
+, _bufferSize(bufferSize)
+, _stats(stats) {
+}
+
+File::~File() {
+	(void)flush();
 }
 
 int64 File::size() const {
-	return _offset;
+	return _offset + _buffer.size();
 }
 
 bool File::empty() const {
-	return !_offset;
+	return !size();
 }
 
 Result File::writeBlock(const QByteArray &block) {
@@ -38,6 +45,14 @@ Result File::writeBlock(const QByteArray &block) {
 	return result;
 }
 
+Result File::flush() {
+	const auto result = writeBufferAttempt();
+	if (!result) {
+		_file.reset();
+	}
+	return result;
+}
+
 Result File::writeBlockAttempt(const QByteArray &block) {
 	if (_stats && !_inStats) {
 		_inStats = true;
@@ -50,7 +65,35 @@ Result File::writeBlockAttempt(const QByteArray &block) {
 	if (!size) {
 		return Result::Success();
 	}
-	if (_file->write(block) == size && _file->flush()) {
+
+	// On failure the block is not consumed, so that a retry with the
+	// same block doesn't write it twice.
+	if (_buffer.size() + size > _bufferSize) {
+		if (const auto result = writeBufferAttempt(); !result) {
+			return result;
+		} else if (size >= _bufferSize) {
+			return writeDataAttempt(block);
+		}
+	}
+	_buffer.append(block);
+	return Result::Success();
+}
+
+Result File::writeBufferAttempt() {
+	if (_buffer.isEmpty()) {
+		return Result::Success();
+	} else if (const auto result = reopen(); !result) {
+		return result;
+	} else if (const auto result = writeDataAttempt(_buffer); !result) {
+		return result;
+	}
+	_buffer.resize(0);
+	return Result::Success();
+}
+
+Result File::writeDataAttempt(const QByteArray &data) {
+	const auto size = data.size();
+	if (_file->write(data) == size && _file->flush()) {
 		_offset += size;
 		if (_stats) {
 			_stats->incrementBytes(size);
@@ -19,14 +19,21 @@ namespace Output {
 struct Result;
 class Stats;
 
+// Buffer size for the files composed by the export writers.
+constexpr auto kWriterBufferSize = 1024 * 1024;
+
 class File {
 public:
-	File(const QString &path, Stats *stats);
+	// With a non-zero bufferSize small blocks are collected in memory
+	// and written together, they reach the disk on flush() at the latest.
+	File(const QString &path, Stats *stats, int bufferSize = 0);
+	~File();
 
 	[[nodiscard]] int64 size() const;
 	[[nodiscard]] bool empty() const;
 
 	[[nodiscard]] Result writeBlock(const QByteArray &block);
+	[[nodiscard]] Result flush();
 
 	[[nodiscard]] static QString PrepareRelativePath(
 		const QString &folder,
@@ -40,6 +47,8 @@ public:
 private:
 	[[nodiscard]] Result reopen();
 	[[nodiscard]] Result writeBlockAttempt(const QByteArray &block);
+	[[nodiscard]] Result writeBufferAttempt();
+	[[nodiscard]] Result writeDataAttempt(const QByteArray &data);
 
 	[[nodiscard]] Result error() const;
 	[[nodiscard]] Result fatalError() const;
@@ -47,6 +56,8 @@ private:
 	QString _path;
 	int64 _offset = 0;
 	std::optional<QFile> _file;
+	QByteArray _buffer;
+	int _bufferSize = 0;
 
 	Stats *_stats = nullptr;
 	bool _inStats = false;
@@ -692,7 +692,7 @@ HtmlWriter::Wrap::Wrap(
 	const QString &path,
 	const QString &base,
 	Stats *stats)
-: _file(path, stats) {
+: _file(path, stats, kWriterBufferSize) {
 	Expects(base.endsWith('/'));
 	Expects(path.startsWith(base));
 
@@ -2435,7 +2435,10 @@ Result HtmlWriter::Wrap::close() {
 		while (!_context.empty()) {
 			block.append(_context.popTag());
 		}
-		return _file.writeBlock(block);
+		if (const auto result = _file.writeBlock(block); !result) {
+			return result;
+		}
+		return _file.flush();
 	}
 	return Result::Success();
 }
@@ -1571,11 +1571,14 @@ Result JsonWriter::finish() {
 
 	if (_settings.onlySinglePeer()) {
 		Assert(_context.nesting.empty());
-		return Result::Success();
+		return _output->flush();
 	}
 	auto block = popNesting();
 	Assert(_context.nesting.empty());
-	return _output->writeBlock(block);
+	if (const auto result = _output->writeBlock(block); !result) {
+		return result;
+	}
+	return _output->flush();
 }
 
 QString JsonWriter::mainFilePath() {
@@ -1592,7 +1595,10 @@ QString JsonWriter::pathWithRelativePath(const QString &path) const {
 
 std::unique_ptr<File> JsonWriter::fileWithRelativePath(
 		const QString &path) const {
-	return std::make_unique<File>(pathWithRelativePath(path), _stats);
+	return std::make_unique<File>(
+		pathWithRelativePath(path),
+		_stats,
+		kWriterBufferSize);
 }
 
 } // namespace Output
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #endif // !TDESKTOP_USE_PACKAGED && !Q_OS_WIN && !Q_OS_MAC
 
 #include <QImage>
+#include <QThread>
 
 #ifdef LIB_FFMPEG_USE_QT_PRIVATE_API
 #include <private/qdrawhelper_p.h>
@@ -37,6 +38,10 @@ constexpr auto kAvioBlockSize = 4096;
 constexpr auto kTimeUnknown = std::numeric_limits<crl::time>::min();
 constexpr auto kDurationMax = crl::time(std::numeric_limits<int>::max());
 
+// Video decoders opened at the same time share the CPU cores between them.
+// Audio and attached picture decoders are cheap, so they are not counted.
+std::atomic<int> VideoDecodersCount = 0;
+
 using GetFormatMethod = enum AVPixelFormat(*)(
 	struct AVCodecContext *s,
 	const enum AVPixelFormat *fmt);
@@ -337,7 +342,19 @@ CodecPointer MakeCodecPointer(CodecDescriptor descriptor) {
 		return {};
 	}
 	context->pkt_timebase = stream->time_base;
-	av_opt_set(context, "threads", "auto", 0);
+	const auto video = (context->codec_type == AVMEDIA_TYPE_VIDEO)
+		&& !(stream->disposition & AV_DISPOSITION_ATTACHED_PIC);
+	if (video) {
+		// The split is fixed once the codec is opened, existing
+		// decoders don't get their threads back when others are closed.
+		const auto decoders = VideoDecodersCount.load() + 1;
+		const auto threads = std::max(
+			QThread::idealThreadCount() / decoders,
+			1);
+		av_opt_set_int(context, "threads", threads, 0);
+	} else {
+		av_opt_set(context, "threads", "auto", 0);
+	}
 	av_opt_set_int(context, "refcounted_frames", 1, 0);
 
 	const auto codec = FindDecoder(context);
@@ -358,12 +375,19 @@ CodecPointer MakeCodecPointer(CodecDescriptor descriptor) {
 		LogError(u"avcodec_open2"_q, error);
 		return {};
 	}
+	if (video) {
+		++VideoDecodersCount;
+		result.get_deleter().countedVideoDecoder = true;
+	}
 	return result;
 }
 
 void CodecDeleter::operator()(AVCodecContext *value) {
 	if (value) {
 		avcodec_free_context(&value);
+		if (countedVideoDecoder) {
+			--VideoDecodersCount;
+		}
 	}
 }
 
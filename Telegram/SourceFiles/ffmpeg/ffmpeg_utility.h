@@ -140,6 +140,8 @@ using FormatPointer = std::unique_ptr<AVFormatContext, FormatDeleter>;
 	int64_t(*seek)(void *opaque, int64_t offset, int whence));
 
 struct CodecDeleter {
+	bool countedVideoDecoder = false;
+
 	void operator()(AVCodecContext *value);
 };
 using CodecPointer = std::unique_ptr<AVCodecContext, CodecDeleter>;
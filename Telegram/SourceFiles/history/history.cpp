@@ -3388,7 +3388,9 @@ void History::resizeToWidth(int newWidth) {
 		: (_width != newWidth)
 		? Request::ResizeAll
 		: Request::ResizePending;
-	if (request == Request::ResizePending && !hasPendingResizedItems()) {
+	if (request == Request::ResizePending
+		&& !hasPendingResizedItems()
+		&& !hasStaleWidthBlocks()) {
 		return;
 	}
 	_flags &= ~(Flag::HasPendingResizedItems | Flag::PendingAllItemsResize);
@@ -3397,11 +3399,45 @@ void History::resizeToWidth(int newWidth) {
 	int y = 0;
 	for (const auto &block : blocks) {
 		block->setY(y);
-		y += block->resizeGetHeight(newWidth, request);
+		y += block->resizeGetHeight(
+			newWidth,
+			((request == Request::ResizePending
+				&& block->width() != newWidth)
+				? Request::ResizeAll
+				: request));
 	}
 	_height = y;
 }
 
+void History::resizeToWidthAround(int newWidth, int top, int bottom) {
+	using Request = HistoryBlock::ResizeRequest;
+	if ((_flags & Flag::PendingAllItemsResize)
+		|| !_width
+		|| _width == newWidth) {
+		resizeToWidth(newWidth);
+		return;
+	}
+	_flags &= ~Flag::HasPendingResizedItems;
+
+	_width = newWidth;
+	int y = 0;
+	for (const auto &block : blocks) {
+		const auto exact = (block->y() < bottom)
+			&& (block->y() + block->height() > top);
+		block->setY(y);
+		y += block->resizeGetHeight(
+			newWidth,
+			exact ? Request::ResizeAll : Request::ResizePending);
+	}
+	_height = y;
+}
+
+bool History::hasStaleWidthBlocks() const {
+	return ranges::any_of(blocks, [&](const auto &block) {
+		return (block->width() != _width);
+	});
+}
+
 void History::forceFullResize() {
 	_width = 0;
 	_flags |= Flag::HasPendingResizedItems;
@@ -3971,12 +4007,24 @@ int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
 			y += message->resizeGetHeight(newWidth);
 		}
 	} else {
+		auto resized = false;
 		for (const auto &message : messages) {
 			message->setY(y);
-			y += message->pendingResize()
-				? message->resizeGetHeight(newWidth)
-				: message->height();
+			if (message->pendingResize()) {
+				resized = true;
+				y += message->resizeGetHeight(newWidth);
+			} else {
+				y += message->height();
+			}
 		}
+
+		// Elements of a stale block now have different widths.
+		if (resized && _width != newWidth) {
+			_width = 0;
+		}
+	}
+	if (request != ResizeRequest::ResizePending) {
+		_width = newWidth;
 	}
 	_height = y;
 	return _height;
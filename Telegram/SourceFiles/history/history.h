@@ -342,6 +342,11 @@ public:
 	HistoryItem *lastEditableMessage() const;
 
 	void resizeToWidth(int newWidth);
+
+	// Only the blocks intersecting [top, bottom) get the new width,
+	// the others keep their heights until the next resizeToWidth().
+	void resizeToWidthAround(int newWidth, int top, int bottom);
+	[[nodiscard]] bool hasStaleWidthBlocks() const;
 	void forceFullResize();
 	int height() const;
 
@@ -752,6 +757,9 @@ public:
 	int height() const {
 		return _height;
 	}
+	int width() const {
+		return _width;
+	}
 	not_null<History*> history() const {
 		return _history;
 	}
@@ -785,6 +793,7 @@ protected:
 	const not_null<History*> _history;
 
 	int _y = 0;
+	int _width = 0;
 	int _height = 0;
 	int _indexInHistory = -1;
 
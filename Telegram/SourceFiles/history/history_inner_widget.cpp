@@ -107,6 +107,7 @@ namespace {
 constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kUnloadHeavyPartsPages = 2;
 constexpr auto kClearUserpicsAfter = 50;
+constexpr auto kExactResizePages = 2;
 
 // Helper binary search for an item in a list that is not completely
 // above the given top of the visible area or below the given bottom of the visible area
@@ -3329,7 +3330,7 @@ void HistoryInner::checkActivation() {
 	session().data().histories().readInboxTill(view->data());
 }
 
-void HistoryInner::recountHistoryGeometry() {
+void HistoryInner::recountHistoryGeometry(bool visibleOnly) {
 	_contentWidth = _scroll->width();
 
 	if (_history->hasPendingResizedItems()
@@ -3347,9 +3348,31 @@ void HistoryInner::recountHistoryGeometry() {
 
 	updateBotInfo(false);
 
-	_history->resizeToWidth(_contentWidth);
-	if (_migrated) {
-		_migrated->resizeToWidth(_contentWidth);
+	if (visibleOnly) {
+		const auto margin = visibleHeight * kExactResizePages;
+		const auto top = _visibleAreaTop - margin;
+		const auto bottom = _visibleAreaBottom + margin;
+		const auto resizeAround = [&](not_null<History*> history, int at) {
+			if (at >= 0) {
+				history->resizeToWidthAround(
+					_contentWidth,
+					top - at,
+					bottom - at);
+			} else {
+				history->resizeToWidth(_contentWidth);
+			}
+		};
+		const auto historyAt = historyTop();
+		const auto migratedAt = migratedTop();
+		resizeAround(_history, historyAt);
+		if (_migrated) {
+			resizeAround(_migrated, migratedAt);
+		}
+	} else {
+		_history->resizeToWidth(_contentWidth);
+		if (_migrated) {
+			_migrated->resizeToWidth(_contentWidth);
+		}
 	}
 
 	// With migrated history we perhaps do not need to display
@@ -4581,6 +4604,11 @@ void HistoryInner::deleteItem(not_null<HistoryItem*> item) {
 	}
 }
 
+bool HistoryInner::hasStaleWidthItems() const {
+	return _history->hasStaleWidthBlocks()
+		|| (_migrated && _migrated->hasStaleWidthBlocks());
+}
+
 bool HistoryInner::hasPendingResizedItems() const {
 	return _history->hasPendingResizedItems()
 		|| (_migrated && _migrated->hasPendingResizedItems());
@@ -134,7 +134,8 @@ public:
 	void setItemsRevealHeight(int revealHeight);
 	void changeItemsRevealHeight(int revealHeight);
 	void checkActivation();
-	void recountHistoryGeometry();
+	void recountHistoryGeometry(bool visibleOnly = false);
+	[[nodiscard]] bool hasStaleWidthItems() const;
 	void updateSize();
 	void setShownPinned(HistoryItem *item);
 
@@ -194,6 +194,7 @@ constexpr auto kSaveDraftTimeout = crl::time(1000);
 constexpr auto kSaveDraftAnywayTimeout = 5 * crl::time(1000);
 constexpr auto kSaveCloudDraftIdleTimeout = 14 * crl::time(1000);
 constexpr auto kRefreshSlowmodeLabelTimeout = crl::time(200);
+constexpr auto kRefineListWidthTimeout = crl::time(200);
 constexpr auto kCommonModifiers = 0
 	| Qt::ShiftModifier
 	| Qt::MetaModifier
@@ -238,6 +239,7 @@ HistoryWidget::HistoryWidget(
 	this,
 	controller->chatStyle()->value(lifetime(), st::historyScroll),
 	false)
+, _refineListWidthTimer([=] { updateHistoryGeometry(); })
 , _updateHistoryItems([=] { updateHistoryItemsByTimer(); })
 , _cornerButtons(
 	_scroll.data(),
@@ -6208,7 +6210,9 @@ void HistoryWidget::updateControlsGeometry() {
 		}
 	}
 
+	_resizingListVisibleOnly = true;
 	updateHistoryGeometry(false, false, { ScrollChangeAdd, _topDelta });
+	_resizingListVisibleOnly = false;
 
 	updateFieldSize();
 
@@ -6628,7 +6632,10 @@ void HistoryWidget::startMessageSendingAnimation(
 void HistoryWidget::updateListSize() {
 	Expects(_list != nullptr);
 
-	_list->recountHistoryGeometry();
+	_list->recountHistoryGeometry(_resizingListVisibleOnly);
+	if (_list->hasStaleWidthItems()) {
+		_refineListWidthTimer.callOnce(kRefineListWidthTimeout);
+	}
 	auto washidden = _scroll->isHidden();
 	if (washidden) {
 		_scroll->show();
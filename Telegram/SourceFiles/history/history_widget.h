@@ -763,6 +763,11 @@ private:
 	// If updateListSize() was called without updateHistoryGeometry().
 	bool _updateHistoryGeometryRequired = false;
 
+	// While resizing only the visible part of the list is laid out,
+	// the rest is refined by the timer when the resizing stops.
+	bool _resizingListVisibleOnly = false;
+	base::Timer _refineListWidthTimer;
+
 	int _lastScrollTop = 0; // gifs optimization
 	crl::time _lastScrolled = 0;
 	base::Timer _updateHistoryItems;
@@ -96,6 +96,10 @@ void SendActionPainter::setTopic(Data::ForumTopic *topic) {
 	_topic = topic;
 }
 
+bool SendActionPainter::animating() const {
+	return _sendActionAnimation || _speakingAnimation;
+}
+
 bool SendActionPainter::updateNeedsAnimating(
 		not_null<UserData*> user,
 		const TLSendAction &action) {
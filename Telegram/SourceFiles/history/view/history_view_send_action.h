@@ -37,6 +37,8 @@ public:
 
 	void setTopic(Data::ForumTopic *topic);
 
+	[[nodiscard]] bool animating() const;
+
 	bool paint(
 		Painter &p,
 		int x,
@@ -105,7 +105,10 @@ void Data::updateCachedViews(int cachedViews) {
 
 void Data::prepare(const Options &options, Fn<void(Prepared)> done) const {
 	crl::async([source = *_source, options, done = std::move(done)] {
-		done(Prepare(source, options));
+		auto result = Prepare(source, options);
+		if (!options.cancelled || !options.cancelled->load()) {
+			done(std::move(result));
+		}
 	});
 }
 
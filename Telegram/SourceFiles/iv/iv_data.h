@@ -17,6 +17,8 @@ namespace Iv {
 struct Source;
 
 struct Options {
+	// Set to true to drop a preparation that is not needed anymore.
+	std::shared_ptr<std::atomic<bool>> cancelled;
 };
 
 struct Prepared {
@@ -76,6 +76,7 @@ public:
 		not_null<Main::Session*> session,
 		not_null<Data*> data,
 		QString hash);
+	~Shown();
 
 	[[nodiscard]] bool showing(
 		not_null<Main::Session*> session,
@@ -163,6 +164,7 @@ private:
 	base::flat_map<DocumentId, FileLoad> _files;
 	base::flat_map<QByteArray, rpl::producer<bool>> _inChannelValues;
 
+	std::shared_ptr<std::atomic<bool>> _preparingCancelled;
 	bool _preparing = false;
 
 	base::flat_map<QByteArray, QByteArray> _embeds;
@@ -220,12 +222,23 @@ Shown::Shown(
 	prepare(data, hash);
 }
 
+Shown::~Shown() {
+	if (_preparingCancelled) {
+		*_preparingCancelled = true;
+	}
+}
+
 void Shown::prepare(not_null<Data*> data, const QString &hash) {
 	const auto weak = base::make_weak(this);
 
+	if (_preparingCancelled) {
+		*_preparingCancelled = true;
+	}
+	_preparingCancelled = std::make_shared<std::atomic<bool>>(false);
 	_preparing = true;
 	const auto id = _id = data->id();
-	data->prepare({}, [=](Prepared result) {
+	const auto options = Options{ .cancelled = _preparingCancelled };
+	data->prepare(options, [=](Prepared result) {
 		result.hash = hash;
 		crl::on_main(weak, [=, result = std::move(result)]() mutable {
 			result.url = id;
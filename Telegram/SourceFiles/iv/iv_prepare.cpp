@@ -280,6 +280,7 @@ private:
 
 	//const Options _options;
 	const QByteArray _fileOriginPostfix;
+	const std::shared_ptr<std::atomic<bool>> _cancelled;
 
 	base::flat_set<QByteArray> _resources;
 
@@ -323,7 +324,8 @@ private:
 
 Parser::Parser(const Source &source, const Options &options)
 : /*_options(options)
-, */_fileOriginPostfix('/' + Number(source.pageId)) {
+, */_fileOriginPostfix('/' + Number(source.pageId))
+, _cancelled(options.cancelled) {
 #if 0 // mtp
 	process(source);
 #endif
@@ -462,6 +464,10 @@ QByteArray Parser::list(const TLvector<Inner> &data) {
 	auto result = QByteArrayList();
 	result.reserve(data.v.size());
 	for (const auto &item : data.v) {
+		if (_cancelled && _cancelled->load()) {
+			// The result is dropped anyway, stop preparing it.
+			return QByteArray();
+		}
 		result.append(item.match([&](const auto &data) {
 			return block(data);
 		}));
@@ -27,6 +27,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <numeric>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define TDESKTOP_AUDIO_PEAKS_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__ || _M_X64 || _M_IX86_FP >= 2
+
 Q_DECLARE_METATYPE(AudioMsgId);
 Q_DECLARE_METATYPE(VoiceWaveform);
 
@@ -227,6 +232,77 @@ bool SupportsSpeedControl() {
 	return result;
 }
 
+uint16 MaxSample(gsl::span<const uchar> samples) {
+	auto data = samples.data();
+	auto count = samples.size();
+
+	// ReadOneSample(uchar) is |sample - 0x80| * 0x100,
+	// so we look for the largest distance from 0x80.
+	auto distance = uchar(0);
+#ifdef TDESKTOP_AUDIO_PEAKS_SSE2
+	if (count >= 16) {
+		const auto middle = _mm_set1_epi8(char(0x80));
+		auto result = _mm_setzero_si128();
+		for (; count >= 16; data += 16, count -= 16) {
+			const auto value = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(data));
+			result = _mm_max_epu8(result, _mm_sub_epi8(
+				_mm_max_epu8(value, middle),
+				_mm_min_epu8(value, middle)));
+		}
+		alignas(16) uchar lanes[16];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), result);
+		for (const auto lane : lanes) {
+			accumulate_max(distance, lane);
+		}
+	}
+#endif // TDESKTOP_AUDIO_PEAKS_SSE2
+	for (; count > 0; ++data, --count) {
+		const auto value = *data;
+		accumulate_max(
+			distance,
+			uchar((value > 0x80) ? (value - 0x80) : (0x80 - value)));
+	}
+	return uint16(distance) * 0x100;
+}
+
+uint16 MaxSample(gsl::span<const int16> samples) {
+	auto data = samples.data();
+	auto count = samples.size();
+
+	auto result = uint16(0);
+#ifdef TDESKTOP_AUDIO_PEAKS_SSE2
+	if (count >= 8) {
+		// There is no unsigned 16 bit max in SSE2, so the absolute
+		// values are shifted by 0x8000 and compared as signed ones.
+		const auto shift = _mm_set1_epi16(short(0x8000));
+		auto shifted = _mm_set1_epi16(short(0x8000));
+		for (; count >= 8; data += 8, count -= 8) {
+			const auto value = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(data));
+			const auto sign = _mm_srai_epi16(value, 15);
+			const auto absolute = _mm_sub_epi16(
+				_mm_xor_si128(value, sign),
+				sign);
+			shifted = _mm_max_epi16(
+				shifted,
+				_mm_xor_si128(absolute, shift));
+		}
+		alignas(16) uint16 lanes[8];
+		_mm_store_si128(
+			reinterpret_cast<__m128i*>(lanes),
+			_mm_xor_si128(shifted, shift));
+		for (const auto lane : lanes) {
+			accumulate_max(result, lane);
+		}
+	}
+#endif // TDESKTOP_AUDIO_PEAKS_SSE2
+	for (; count > 0; ++data, --count) {
+		accumulate_max(result, ReadOneSample(*data));
+	}
+	return result;
+}
+
 } // namespace Audio
 
 namespace Player {
@@ -1558,14 +1634,18 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
-			}
+		auto callback = [&](uint16 value) {
+			peaks.push_back(value);
+		};
+		const auto iterate = [&](auto sample, bytes::const_span bytes) {
+			using SampleType = decltype(sample);
+			Media::Audio::IteratePeaks<SampleType>(
+				bytes,
+				Media::Player::kWaveformSamplesCount,
+				countbytes,
+				sumbytes,
+				peak,
+				callback);
 		};
 		while (processed < countbytes) {
 			const auto result = readMore();
@@ -1580,9 +1660,9 @@ public:
 			const auto sampleBytes = v::get<bytes::const_span>(result);
 			Assert(!sampleBytes.empty());
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				iterate(uchar(), sampleBytes);
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				iterate(int16(), sampleBytes);
 			}
 			processed += sampleBytes.size();
 		}
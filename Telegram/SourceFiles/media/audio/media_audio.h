@@ -420,5 +420,49 @@ void IterateSamples(bytes::const_span bytes, Callback &&callback) {
 	}
 }
 
+// Maximum of ReadOneSample() over the samples, zero for an empty span.
+[[nodiscard]] uint16 MaxSample(gsl::span<const uchar> samples);
+[[nodiscard]] uint16 MaxSample(gsl::span<const int16> samples);
+
+// Same as calling for each sample:
+//
+// accumulate_max(peak, ReadOneSample(sample));
+// if ((accumulated += step) >= threshold) {
+//	accumulated -= threshold;
+//	callback(peak);
+//	peak = 0;
+// }
+//
+// But runs of samples between the callbacks are reduced by MaxSample().
+template <typename SampleType, typename Callback>
+void IteratePeaks(
+		bytes::const_span bytes,
+		int64 step,
+		int64 threshold,
+		int64 &accumulated,
+		uint16 &peak,
+		Callback &&callback) {
+	Expects(step > 0 && step <= threshold);
+	Expects(accumulated < threshold);
+
+	auto samples = gsl::make_span(
+		reinterpret_cast<const SampleType*>(bytes.data()),
+		bytes.size() / sizeof(SampleType));
+	while (!samples.empty()) {
+		const auto left = threshold - accumulated;
+		const auto count = std::min(
+			int64(samples.size()),
+			(left + step - 1) / step);
+		accumulate_max(peak, MaxSample(samples.subspan(0, count)));
+		accumulated += count * step;
+		if (accumulated >= threshold) {
+			accumulated -= threshold;
+			callback(peak);
+			peak = 0;
+		}
+		samples = samples.subspan(count);
+	}
+}
+
 } // namespace Audio
 } // namespace Media
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/audio/media_audio_capture.h"
 
 #include "media/audio/media_audio_capture_common.h"
+#include "media/audio/media_audio.h"
 #include "media/audio/media_audio_ffmpeg_loader.h"
 #include "media/audio/media_audio_track.h"
 #include "ffmpeg/ffmpeg_utility.h"
@@ -664,17 +665,23 @@ void Instance::Inner::process() {
 		auto skipSamples = kCaptureSkipDuration * kCaptureFrequency / 1000;
 		auto fadeSamples = kCaptureFadeInDuration * kCaptureFrequency / 1000;
 		auto levelindex = d->fullSamples + static_cast<int>(s / sizeof(short));
-		for (auto ptr = (const short*)(_captured.constData() + s), end = (const short*)(_captured.constData() + news); ptr < end; ++ptr, ++levelindex) {
+		auto ptr = (const short*)(_captured.constData() + s);
+		const auto end = (const short*)(_captured.constData() + news);
+		const auto fadeTill = skipSamples + fadeSamples;
+		for (; ptr < end && levelindex < fadeTill; ++ptr, ++levelindex) {
 			if (levelindex > skipSamples) {
-				uint16 value = qAbs(*ptr);
-				if (levelindex < skipSamples + fadeSamples) {
-					value = qRound(value * float64(levelindex - skipSamples) / fadeSamples);
-				}
-				if (d->levelMax < value) {
-					d->levelMax = value;
-				}
+				const auto value = uint16(qRound(
+					uint16(qAbs(*ptr))
+					* float64(levelindex - skipSamples)
+					/ fadeSamples));
+				accumulate_max(d->levelMax, value);
 			}
 		}
+		if (ptr < end) {
+			accumulate_max(
+				d->levelMax,
+				Media::Audio::MaxSample(gsl::make_span(ptr, end)));
+		}
 		qint32 samplesFull = d->fullSamples + _captured.size() / sizeof(short), samplesSinceUpdate = samplesFull - d->lastUpdate;
 		if (samplesSinceUpdate > kCaptureUpdateDelta * kCaptureFrequency / 1000) {
 			_updated(Update{ .samples = samplesFull, .level = d->levelMax });
@@ -64,19 +64,24 @@ void Track::fillFromData(bytes::vector &&data) {
 	const auto peaksCount = _peakEachPosition ? (samplesCount / _peakEachPosition) : 0;
 	_peaks.reserve(peaksCount);
 	auto peakValue = uint16(0);
-	auto peakSamples = 0;
+	auto peakSamples = int64(0);
 	auto peakEachSample = (format == AL_FORMAT_STEREO8 || format == AL_FORMAT_STEREO16) ? (_peakEachPosition * 2) : _peakEachPosition;
 	_peakValueMin = 0x7FFF;
 	_peakValueMax = 0;
-	auto peakCallback = [this, &peakValue, &peakSamples, peakEachSample](uint16 sample) {
-		accumulate_max(peakValue, sample);
-		if (++peakSamples >= peakEachSample) {
-			peakSamples -= peakEachSample;
-			_peaks.push_back(peakValue);
-			accumulate_max(_peakValueMax, peakValue);
-			accumulate_min(_peakValueMin, peakValue);
-			peakValue = 0;
-		}
+	auto peakCallback = [this](uint16 value) {
+		_peaks.push_back(value);
+		accumulate_max(_peakValueMax, value);
+		accumulate_min(_peakValueMin, value);
+	};
+	const auto iteratePeaks = [&](auto sample, bytes::const_span bytes) {
+		using SampleType = decltype(sample);
+		Media::Audio::IteratePeaks<SampleType>(
+			bytes,
+			1,
+			peakEachSample,
+			peakSamples,
+			peakValue,
+			peakCallback);
 	};
 	do {
 		using Error = AudioPlayerLoader::ReadError;
@@ -98,9 +103,9 @@ void Track::fillFromData(bytes::vector &&data) {
 		_samples.insert(_samples.end(), sampleBytes.data(), sampleBytes.data() + sampleBytes.size());
 		if (peaksCount) {
 			if (format == AL_FORMAT_MONO8 || format == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, peakCallback);
+				iteratePeaks(uchar(), sampleBytes);
 			} else if (format == AL_FORMAT_MONO16 || format == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, peakCallback);
+				iteratePeaks(int16(), sampleBytes);
 			}
 		}
 	} while (true);
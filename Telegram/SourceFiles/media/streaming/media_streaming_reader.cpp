@@ -22,6 +22,8 @@ constexpr auto kMaxPartsInHeader = 64;
 constexpr auto kMaxOnlyInHeader = 80 * kPartSize;
 constexpr auto kPartsOutsideFirstSliceGood = 8;
 constexpr auto kSlicesInMemory = 2;
+constexpr auto kMaxSlicesInMemory = 8;
+constexpr auto kSlicesMemoryBudget = 6 * int64(kInSlice);
 
 // 1 MB of parts are requested from cloud ahead of reading demand.
 constexpr auto kPreloadPartsAhead = 8;
@@ -29,11 +31,46 @@ constexpr auto kDownloaderRequestsLimit = 4;
 
 using PartsMap = base::flat_map<uint32, QByteArray>;
 
+// Readers of files that don't fit in the header share the budget.
+std::atomic<int> SlicedReadersCount = 0;
+
 struct ParsedCacheEntry {
 	PartsMap parts;
 	std::optional<PartsMap> included;
 };
 
+int SlicesInMemory() {
+	const auto readers = std::max(
+		SlicedReadersCount.load(std::memory_order_relaxed),
+		1);
+	return std::clamp(
+		int(kSlicesMemoryBudget / (readers * int64(kInSlice))),
+		kSlicesInMemory,
+		kMaxSlicesInMemory);
+}
+
+int ComplexPartsMapSize(const PartsMap &parts) {
+	auto result = int((parts.size() * 2 + 1) * sizeof(int32));
+	for (const auto &[offset, part] : parts) {
+		result += part.size();
+	}
+	return result;
+}
+
+void AppendComplexPartsMap(QByteArray &to, const PartsMap &parts) {
+	const auto intSize = sizeof(int32);
+	const auto appendInt = [&](int value) {
+		auto serialized = int32(value);
+		to.append(reinterpret_cast<const char*>(&serialized), intSize);
+	};
+	appendInt(parts.size());
+	for (const auto &[offset, part] : parts) {
+		appendInt(offset);
+		appendInt(part.size());
+		to.append(part);
+	}
+}
+
 bool IsContiguousSerialization(int serializedSize, int maxSliceSize) {
 	return !(serializedSize % kPartSize) || (serializedSize == maxSliceSize);
 }
@@ -351,6 +388,13 @@ Reader::Slices::Slices(uint32 size, bool useCache)
 	}
 	if (!isFullInHeader()) {
 		_data.resize(SlicesCount(_size));
+		++SlicedReadersCount;
+	}
+}
+
+Reader::Slices::~Slices() {
+	if (!_data.empty()) {
+		--SlicedReadersCount;
 	}
 }
 
@@ -713,7 +757,7 @@ Reader::SerializedSlice Reader::Slices::serializeAndUnloadUnused() {
 	using Flag = Slice::Flag;
 
 	if (_headerMode == HeaderMode::Unknown
-		|| _usedSlices.size() <= kSlicesInMemory) {
+		|| int(_usedSlices.size()) <= SlicesInMemory()) {
 		return {};
 	}
 	const auto purgeSlice = _usedSlices.front();
@@ -775,9 +819,20 @@ Reader::SerializedSlice Reader::Slices::serializeAndUnloadSlice(
 			result.data.append(part);
 		}
 	} else {
-		result.data = serializeComplexSlice(slice);
 		if (writeHeaderAndSlice) {
-			result.data.append(serializeAndUnloadFirstSliceNoHeader());
+			removeHeaderPartsFromFirstSlice();
+		}
+
+		// Both maps go to one buffer, with room for the padding below.
+		const auto firstSize = writeHeaderAndSlice
+			? ComplexPartsMapSize(_data[0].parts)
+			: 0;
+		result.data.reserve(
+			ComplexPartsMapSize(slice.parts) + firstSize + 2);
+		AppendComplexPartsMap(result.data, slice.parts);
+		if (writeHeaderAndSlice) {
+			AppendComplexPartsMap(result.data, _data[0].parts);
+			unloadSlice(_data[0]);
 		}
 
 		// Make sure this data won't be taken for full continuous data.
@@ -806,20 +861,13 @@ void Reader::Slices::unloadSlice(Slice &slice) const {
 	}
 }
 
-QByteArray Reader::Slices::serializeComplexSlice(const Slice &slice) const {
-	return SerializeComplexPartsMap(slice.parts);
-}
-
-QByteArray Reader::Slices::serializeAndUnloadFirstSliceNoHeader() {
+void Reader::Slices::removeHeaderPartsFromFirstSlice() {
 	Expects(_data[0].flags & Slice::Flag::LoadedFromCache);
 
 	auto &slice = _data[0];
 	for (const auto &[offset, part] : _header.parts) {
 		slice.parts.erase(offset);
 	}
-	auto result = serializeComplexSlice(slice);
-	unloadSlice(slice);
-	return result;
 }
 
 Reader::SerializedSlice Reader::Slices::unloadToCache() {
@@ -1398,21 +1446,8 @@ Reader::~Reader() {
 QByteArray SerializeComplexPartsMap(
 		const base::flat_map<uint32, QByteArray> &parts) {
 	auto result = QByteArray();
-	const auto count = parts.size();
-	const auto intSize = sizeof(int32);
-	result.reserve(count * kPartSize + 2 * intSize * (count + 1));
-	const auto appendInt = [&](int value) {
-		auto serialized = int32(value);
-		result.append(
-			reinterpret_cast<const char*>(&serialized),
-			intSize);
-	};
-	appendInt(count);
-	for (const auto &[offset, part] : parts) {
-		appendInt(offset);
-		appendInt(part.size());
-		result.append(part);
-	}
+	result.reserve(ComplexPartsMapSize(parts));
+	AppendComplexPartsMap(result, parts);
 	return result;
 }
 
@@ -147,6 +147,9 @@ private:
 	class Slices {
 	public:
 		Slices(uint32 size, bool useCache);
+		Slices(const Slices &other) = delete;
+		Slices &operator=(const Slices &other) = delete;
+		~Slices();
 
 		void headerDone(bool fromCache);
 		[[nodiscard]] int headerSize() const;
@@ -183,9 +186,7 @@ private:
 		[[nodiscard]] SerializedSlice serializeAndUnloadSlice(
 			int sliceNumber);
 		[[nodiscard]] SerializedSlice serializeAndUnloadUnused();
-		[[nodiscard]] QByteArray serializeComplexSlice(
-			const Slice &slice) const;
-		[[nodiscard]] QByteArray serializeAndUnloadFirstSliceNoHeader();
+		void removeHeaderPartsFromFirstSlice();
 		void markSliceUsed(int sliceIndex);
 		[[nodiscard]] bool computeIsGoodHeader() const;
 		[[nodiscard]] FillResult fillFromHeader(
@@ -436,8 +436,8 @@ void DedicatedLoader::startLoading() {
 		}
 		do {
 			const auto read = std::min(int(downloadedTill - _writtenTill), kChunkSize);
-			const auto bytes = _proxy->read(read);
-			if (bytes.size() != read) {
+			const auto bytes = _proxy->readView(read);
+			if (int(bytes.size()) != read) {
 				LOG(("Update Error: MTP proxy read failed: %1 (%2 of %3)."
 					).arg(bytes.size()
 					).arg(read
@@ -446,7 +446,7 @@ void DedicatedLoader::startLoading() {
 				return;
 			}
 			_writtenTill += read;
-			writeChunk(bytes::make_span(bytes), _size);
+			writeChunk(bytes, _size);
 		} while (writeRequired());
 	};
 	_writtenTill = alreadySize();
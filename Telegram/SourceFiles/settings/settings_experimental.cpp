@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/launcher.h"
 #include "chat_helpers/tabbed_panel.h"
+#include "dialogs/dialogs_inner_widget.h"
 #include "dialogs/dialogs_widget.h"
 #include "info/profile/info_profile_actions.h"
 #include "lang/lang_keys.h"
@@ -142,6 +143,7 @@ void SetupExperimental(
 
 	addToggle(ChatHelpers::kOptionTabbedPanelShowOnClick);
 	addToggle(Dialogs::kOptionForumHideChatsList);
+	addToggle(Dialogs::kOptionCacheChatsListRows);
 	addToggle(Core::kOptionFractionalScalingEnabled);
 	addToggle(Window::kOptionViewProfileInChatsListContextMenu);
 	addToggle(Info::Profile::kOptionShowPeerIdBelowAbout);
@@ -11,60 +11,38 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Statistic {
 
+// Bottom-up segment tree over an implicit heap: node i has children
+// 2 * i and 2 * i + 1, leaves start at the index equal to the array size.
+// Aggregates are kept in separate arrays, so a query touches only
+// the values it needs.
 class SegmentTree final {
 public:
 	SegmentTree() = default;
 	SegmentTree(std::vector<ChartValue> array);
 
 	[[nodiscard]] bool empty() const {
-		return _array.empty();
+		return !_size;
 	}
 	[[nodiscard]] explicit operator bool() const {
 		return !empty();
 	}
 
-	[[nodiscard]] ChartValue rMaxQ(int from, int to);
-	[[nodiscard]] ChartValue rMinQ(int from, int to);
+	// Inclusive ranges, clamped to the array bounds.
+	[[nodiscard]] ChartValue rMaxQ(int from, int to) const;
+	[[nodiscard]] ChartValue rMinQ(int from, int to) const;
 
 private:
-	struct Node final {
-		ChartValue sum = 0;
-		ChartValue max = 0;
-		ChartValue min = 0;
-
-		struct PendingVal {
-			[[nodiscard]] explicit operator bool() const {
-				return available;
-			}
-			ChartValue value = 0;
-			bool available = false;
-		};
-		PendingVal pendingVal;
-
-		int from = 0;
-		int to = 0;
-
-		[[nodiscard]] int size() {
-			return to - from + 1;
-		}
-	};
-
-	void build(ChartValue v, int from, int size);
-	void propagate(ChartValue v);
-	void change(Node &n, ChartValue value);
-
-	[[nodiscard]] ChartValue rMaxQ(ChartValue v, int from, int to);
-	[[nodiscard]] ChartValue rMinQ(ChartValue v, int from, int to);
-
-	[[nodiscard]] bool contains(int from1, int to1, int from2, int to2) const;
-	[[nodiscard]] bool intersects(
-		int from1,
-		int to1,
-		int from2,
-		int to2) const;
-
-	std::vector<ChartValue> _array;
-	std::vector<Node> _heap;
+	template <typename Aggregate>
+	[[nodiscard]] ChartValue query(
+		const std::vector<ChartValue> &values,
+		int from,
+		int to,
+		ChartValue initial,
+		Aggregate aggregate) const;
+
+	int _size = 0;
+	std::vector<ChartValue> _max;
+	std::vector<ChartValue> _min;
 
 };
 
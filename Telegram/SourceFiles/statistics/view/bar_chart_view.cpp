@@ -16,6 +16,17 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "styles/style_statistics.h"
 
 namespace Statistic {
+namespace {
+
+constexpr auto kDecimateAfterBarsPerPixel = 2;
+
+struct PixelColumn final {
+	float64 x = 0.;
+	int pixel = 0;
+	float64 height = 0.;
+};
+
+} // namespace
 
 BarChartView::BarChartView(bool isStack)
 : _isStack(isStack)
@@ -65,12 +76,46 @@ void BarChartView::paintChartAndSelected(
 			anim::interpolateF(1.0, kSelectedAlpha, _lastSelectedXProgress));
 	}
 
+	// With years of daily bars there are many of them per pixel, paint
+	// only the highest stack of each pixel column over the whole column.
+	const auto decimate = _isStack
+		&& (w * kDecimateAfterBarsPerPixel < 1.);
+	auto columns = std::vector<PixelColumn>();
+	if (decimate) {
+		const auto linesFilter = linesFilterController();
+		const auto stackHeight = [&](float64 x) {
+			auto result = 0.;
+			for (const auto &line : c.chartData.lines) {
+				if (line.y[x] > 0) {
+					result += line.y[x] * linesFilter->alpha(line.id);
+				}
+			}
+			return result;
+		};
+		for (auto x = localStart; x <= localEnd; x++) {
+			const auto pixel = int(std::floor(
+				leftStart + (x - localStart) * w));
+			// The selected bar always represents its column.
+			const auto height = (x == _lastSelectedXIndex)
+				? std::numeric_limits<float64>::max()
+				: stackHeight(x);
+			if (columns.empty() || columns.back().pixel != pixel) {
+				columns.push_back({ x, pixel, height });
+			} else if (height > columns.back().height) {
+				columns.back().x = x;
+				columns.back().height = height;
+			}
+		}
+	}
+	auto selectedLeft = leftStart + (_lastSelectedXIndex - localStart) * w;
+	auto selectedWidth = w;
+
 	for (auto i = 0; i < c.chartData.lines.size(); i++) {
 		const auto &line = c.chartData.lines[i];
 		auto path = QPainterPath();
-		for (auto x = localStart; x <= localEnd; x++) {
+		const auto addColumn = [&](float64 x, float64 left, float64 width) {
 			if (line.y[x] <= 0 && _isStack) {
-				continue;
+				return;
 			}
 			const auto yPercentage = (line.y[x] - c.heightLimits.min)
 				/ float64(c.heightLimits.max - c.heightLimits.min);
@@ -80,12 +125,14 @@ void BarChartView::paintChartAndSelected(
 
 			const auto bottomIndex = x - localStart;
 			const auto column = QRectF(
-				leftStart + (x - localStart) * w,
+				left,
 				c.rect.height() - bottoms[bottomIndex] - yPoint,
-				w,
+				width,
 				yPoint);
 			if (hasSelectedXIndex && (x == _lastSelectedXIndex)) {
 				selectedBottoms[i] = column.y();
+				selectedLeft = left;
+				selectedWidth = width;
 			}
 			if (_isStack) {
 				path.addRect(column);
@@ -102,6 +149,15 @@ void BarChartView::paintChartAndSelected(
 					path.lineTo(rect::right(column), column.y());
 				}
 			}
+		};
+		if (decimate) {
+			for (const auto &column : columns) {
+				addColumn(column.x, column.pixel, 1.);
+			}
+		} else {
+			for (auto x = localStart; x <= localEnd; x++) {
+				addColumn(x, leftStart + (x - localStart) * w, w);
+			}
 		}
 		if (_isStack) {
 			p.fillPath(path, line.color);
@@ -124,9 +180,9 @@ void BarChartView::paintChartAndSelected(
 			* linesFilterController()->alpha(line.id);
 
 		const auto column = QRectF(
-			leftStart + (_lastSelectedXIndex - localStart) * w,
+			selectedLeft,
 			selectedBottoms[i],
-			w,
+			selectedWidth,
 			yPoint);
 		p.fillRect(column, line.color);
 	}
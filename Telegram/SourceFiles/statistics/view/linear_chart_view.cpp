@@ -18,6 +18,48 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Statistic {
 namespace {
 
+constexpr auto kDecimateAfterPointsPerPixel = 4;
+
+// Keeps the first, the last, the top and the bottom points of a pixel
+// column, so the decimated polyline covers the same pixels.
+struct ColumnBucket final {
+	void add(int index, QPointF point) {
+		if (!count++) {
+			first = top = bottom = point;
+			topIndex = bottomIndex = index;
+		} else if (point.y() < top.y()) {
+			top = point;
+			topIndex = index;
+		} else if (point.y() > bottom.y()) {
+			bottom = point;
+			bottomIndex = index;
+		}
+		last = point;
+	}
+	void flush(QPolygonF &points) {
+		if (!count) {
+			return;
+		}
+		points << first;
+		if (topIndex < bottomIndex) {
+			points << top << bottom;
+		} else {
+			points << bottom << top;
+		}
+		points << last;
+		count = 0;
+	}
+
+	int column = 0;
+	int count = 0;
+	QPointF first;
+	QPointF last;
+	QPointF top;
+	QPointF bottom;
+	int topIndex = 0;
+	int bottomIndex = 0;
+};
+
 void PaintChartLine(
 		QPainter &p,
 		int lineIndex,
@@ -35,6 +77,11 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
+	// With years of daily points there are many of them per pixel,
+	// reduce them to at most four points per pixel column.
+	const auto decimate = (localEnd - localStart + 1)
+		> (kDecimateAfterPointsPerPixel * c.rect.width());
+	auto bucket = ColumnBucket();
 	for (auto i = localStart; i <= localEnd; i++) {
 		if (line.y[i] < 0) {
 			continue;
@@ -45,8 +92,18 @@ void PaintChartLine(
 		const auto yPercentage = (line.y[i] * ratio - c.heightLimits.min)
 			/ float64(c.heightLimits.max - c.heightLimits.min);
 		const auto yPoint = (1. - yPercentage) * c.rect.height();
-		chartPoints << QPointF(xPoint, yPoint);
+		if (!decimate) {
+			chartPoints << QPointF(xPoint, yPoint);
+			continue;
+		}
+		const auto column = int(std::floor(xPoint));
+		if (bucket.count && bucket.column != column) {
+			bucket.flush(chartPoints);
+		}
+		bucket.column = column;
+		bucket.add(i, QPointF(xPoint, yPoint));
 	}
+	bucket.flush(chartPoints);
 	p.setPen(QPen(
 		line.color,
 		c.footer ? st::lineWidth : st::statisticsChartLineWidth));
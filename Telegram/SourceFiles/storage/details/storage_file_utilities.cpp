@@ -28,10 +28,71 @@ constexpr auto kStrongIterationsCount = 100'000;
 struct WriteEntry {
 	QString basePath;
 	QString base;
+	std::vector<FileWritePart> parts;
+};
+
+struct WriteData {
 	QByteArray data;
 	QByteArray md5;
 };
 
+[[nodiscard]] QByteArray EncryptPrepared(
+		QByteArray &toEncrypt,
+		const MTP::AuthKeyPtr &key) {
+	// prepare for encryption
+	uint32 size = toEncrypt.size(), fullSize = size;
+	if (fullSize & 0x0F) {
+		fullSize += 0x10 - (fullSize & 0x0F);
+		toEncrypt.resize(fullSize);
+		base::RandomFill(toEncrypt.data() + size, fullSize - size);
+	}
+	*(uint32*)toEncrypt.data() = size;
+	QByteArray encrypted(0x10 + fullSize, Qt::Uninitialized); // 128bit of sha1 - key128, sizeof(data), data
+	hashSha1(toEncrypt.constData(), toEncrypt.size(), encrypted.data());
+	MTP::aesEncryptLocal(toEncrypt.constData(), encrypted.data() + 0x10, fullSize, key, encrypted.constData());
+
+	return encrypted;
+}
+
+void RemoveFiles(const QString &base) {
+	QFile::remove(base + '0');
+	QFile::remove(base + '1');
+	QFile::remove(base + 's');
+}
+
+[[nodiscard]] WriteData PrepareWriteData(std::vector<FileWritePart> &&parts) {
+	auto result = WriteData();
+	auto buffer = QBuffer(&result.data);
+	const auto opened = buffer.open(QIODevice::WriteOnly);
+	Assert(opened);
+	auto stream = QDataStream(&buffer);
+
+	auto md5 = HashMd5();
+	auto fullSize = 0;
+	for (auto &part : parts) {
+		const auto data = part.key
+			? EncryptPrepared(part.data, part.key)
+			: std::move(part.data);
+		stream << data;
+		quint32 len = data.isNull() ? 0xffffffff : data.size();
+		if (QSysInfo::ByteOrder != QSysInfo::BigEndian) {
+			len = qbswap(len);
+		}
+		md5.feed(&len, sizeof(len));
+		md5.feed(data.constData(), data.size());
+		fullSize += sizeof(len) + data.size();
+	}
+	stream.setDevice(nullptr);
+	buffer.close();
+
+	md5.feed(&fullSize, sizeof(fullSize));
+	qint32 version = AppVersion;
+	md5.feed(&version, sizeof(version));
+	md5.feed(TdfMagic, TdfMagicLen);
+	result.md5 = QByteArray((const char*)md5.result(), 0x10);
+	return result;
+}
+
 class WriteManager final {
 public:
 	explicit WriteManager(crl::weak_on_thread<WriteManager> weak);
@@ -39,6 +100,7 @@ public:
 	void write(WriteEntry &&entry);
 	void writeSync(WriteEntry &&entry);
 	void writeSyncAll();
+	void remove(const QString &base);
 
 private:
 	void scheduleWrite();
@@ -63,6 +125,7 @@ class AsyncWriteManager final {
 public:
 	void write(WriteEntry &&entry);
 	void writeSync(WriteEntry &&entry);
+	void remove(const QString &base);
 	void sync();
 	void stop();
 
@@ -94,7 +157,16 @@ void WriteManager::writeSync(WriteEntry &&entry) {
 	writeNow(std::move(entry));
 }
 
+void WriteManager::remove(const QString &base) {
+	const auto i = ranges::find(_scheduled, base, &WriteEntry::base);
+	if (i != end(_scheduled)) {
+		_scheduled.erase(i);
+	}
+	RemoveFiles(base);
+}
+
 void WriteManager::writeNow(WriteEntry &&entry) {
+	const auto prepared = PrepareWriteData(base::take(entry.parts));
 	const auto path = [&](char postfix) {
 		return this->path(entry, postfix);
 	};
@@ -102,8 +174,8 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 		return this->open(file, entry, postfix);
 	};
 	const auto write = [&](auto &file) {
-		file.write(entry.data);
-		file.write(entry.md5);
+		file.write(prepared.data);
+		file.write(prepared.md5);
 	};
 	const auto safe = path('s');
 	const auto simple = path('0');
@@ -218,6 +290,18 @@ void AsyncWriteManager::writeSync(WriteEntry &&entry) {
 	});
 }
 
+void AsyncWriteManager::remove(const QString &base) {
+	if (_finished) {
+		RemoveFiles(base);
+		return;
+	} else if (!_manager) {
+		_manager.emplace();
+	}
+	_manager->with([=](WriteManager &manager) {
+		manager.remove(base);
+	});
+}
+
 void AsyncWriteManager::sync() {
 	if (_manager) {
 		_manager->with_sync([](WriteManager &manager) {
@@ -280,14 +364,7 @@ FileKey GenerateKey(const QString &basePath) {
 }
 
 void ClearKey(const FileKey &key, const QString &basePath) {
-	QString name;
-	name.reserve(basePath.size() + 0x11);
-	name.append(basePath).append(ToFilePart(key)).append('0');
-	QFile::remove(name);
-	name[name.size() - 1] = '1';
-	QFile::remove(name);
-	name[name.size() - 1] = 's';
-	QFile::remove(name);
+	Manager.remove(basePath + ToFilePart(key));
 }
 
 bool CheckStreamStatus(QDataStream &stream) {
@@ -388,60 +465,41 @@ FileWriteDescriptor::FileWriteDescriptor(
 	const QString &basePath,
 	bool sync)
 : _basePath(basePath)
+, _base(basePath + name)
 , _sync(sync) {
-	init(name);
 }
 
 FileWriteDescriptor::~FileWriteDescriptor() {
 	finish();
 }
 
-void FileWriteDescriptor::init(const QString &name) {
-	_base = _basePath + name;
-	_buffer.setBuffer(&_safeData);
-	const auto opened = _buffer.open(QIODevice::WriteOnly);
-	Assert(opened);
-	_stream.setDevice(&_buffer);
-}
-
 void FileWriteDescriptor::writeData(const QByteArray &data) {
-	if (!_stream.device()) {
+	if (_finished) {
 		return;
 	}
-	_stream << data;
-	quint32 len = data.isNull() ? 0xffffffff : data.size();
-	if (QSysInfo::ByteOrder != QSysInfo::BigEndian) {
-		len = qbswap(len);
-	}
-	_md5.feed(&len, sizeof(len));
-	_md5.feed(data.constData(), data.size());
-	_fullSize += sizeof(len) + data.size();
+	_parts.push_back({ .data = data });
 }
 
 void FileWriteDescriptor::writeEncrypted(
-	EncryptedDescriptor &data,
-	const MTP::AuthKeyPtr &key) {
-	writeData(PrepareEncrypted(data, key));
+		EncryptedDescriptor &data,
+		const MTP::AuthKeyPtr &key) {
+	if (_finished) {
+		return;
+	}
+	data.finish();
+	_parts.push_back({ .data = base::take(data.data), .key = key });
 }
 
 void FileWriteDescriptor::finish() {
-	if (!_stream.device()) {
+	if (_finished) {
 		return;
 	}
-
-	_stream.setDevice(nullptr);
-	_md5.feed(&_fullSize, sizeof(_fullSize));
-	qint32 version = AppVersion;
-	_md5.feed(&version, sizeof(version));
-	_md5.feed(TdfMagic, TdfMagicLen);
-
-	_buffer.close();
+	_finished = true;
 
 	auto entry = WriteEntry{
 		.basePath = _basePath,
 		.base = _base,
-		.data = _safeData,
-		.md5 = QByteArray((const char*)_md5.result(), 0x10)
+		.parts = base::take(_parts),
 	};
 	if (_sync) {
 		Manager.writeSync(std::move(entry));
@@ -454,21 +512,7 @@ void FileWriteDescriptor::finish() {
 		EncryptedDescriptor &data,
 		const MTP::AuthKeyPtr &key) {
 	data.finish();
-	QByteArray &toEncrypt(data.data);
-
-	// prepare for encryption
-	uint32 size = toEncrypt.size(), fullSize = size;
-	if (fullSize & 0x0F) {
-		fullSize += 0x10 - (fullSize & 0x0F);
-		toEncrypt.resize(fullSize);
-		base::RandomFill(toEncrypt.data() + size, fullSize - size);
-	}
-	*(uint32*)toEncrypt.data() = size;
-	QByteArray encrypted(0x10 + fullSize, Qt::Uninitialized); // 128bit of sha1 - key128, sizeof(data), data
-	hashSha1(toEncrypt.constData(), toEncrypt.size(), encrypted.data());
-	MTP::aesEncryptLocal(toEncrypt.constData(), encrypted.data() + 0x10, fullSize, key, encrypted.constData());
-
-	return encrypted;
+	return EncryptPrepared(data.data, key);
 }
 
 bool ReadFile(
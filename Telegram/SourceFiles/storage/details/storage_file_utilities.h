@@ -52,6 +52,13 @@ struct EncryptedDescriptor final {
 	EncryptedDescriptor &data,
 	const MTP::AuthKeyPtr &key);
 
+// The data is serialized, encrypted and hashed on the writer thread,
+// so the calling thread only collects the parts.
+struct FileWritePart {
+	QByteArray data;
+	MTP::AuthKeyPtr key; // Encrypt the data with this key, if set.
+};
+
 class FileWriteDescriptor final {
 public:
 	FileWriteDescriptor(
@@ -70,17 +77,13 @@ public:
 		const MTP::AuthKeyPtr &key);
 
 private:
-	void init(const QString &name);
 	void finish();
 
 	const QString _basePath;
-	QBuffer _buffer;
-	QDataStream _stream;
-	QByteArray _safeData;
-	QString _base;
-	HashMd5 _md5;
-	int _fullSize = 0;
+	const QString _base;
+	std::vector<FileWritePart> _parts;
 	bool _sync = false;
+	bool _finished = false;
 
 };
 
@@ -177,12 +177,15 @@ void TdbFileLoader::apply(
 	}
 	while (leftToRead > 0) {
 		const auto read = std::min(leftToRead, kMaxReadPart);
-		const auto bytes = _proxy->read(read);
-		if (bytes.size() != read) {
+		const auto bytes = _proxy->readView(read);
+		if (int64(bytes.size()) != read) {
 			cancel(FailureReason::OtherFailure);
 			return;
 		}
-		if (!feedPart(_loadOffset, bytes) || !weak) {
+		const auto raw = QByteArray::fromRawData(
+			reinterpret_cast<const char*>(bytes.data()),
+			bytes.size());
+		if (!feedPart(_loadOffset, raw) || !weak) {
 			break;
 		}
 		_loadOffset += read;
@@ -231,7 +231,8 @@ int PhotoSideLimit() {
 	return PhotoSideLimit(SendLargePhotos.value());
 }
 
-TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
+TaskQueue::TaskQueue(crl::time stopTimeoutMs, int threadsCount)
+: _threadsCount(std::max(threadsCount, 1)) {
 	if (stopTimeoutMs > 0) {
 		_stopTimer = new QTimer(this);
 		connect(_stopTimer, SIGNAL(timeout()), this, SLOT(stop()));
@@ -243,95 +244,107 @@ TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
 TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 	const auto result = task->id();
 	{
-		QMutexLocker lock(&_tasksToProcessMutex);
+		QMutexLocker lock(&_tasksMutex);
 		_tasksToProcess.push_back(std::move(task));
 	}
 
-	wakeThread();
+	wakeThreads();
 
 	return result;
 }
 
 void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 	{
-		QMutexLocker lock(&_tasksToProcessMutex);
+		QMutexLocker lock(&_tasksMutex);
 		for (auto &task : tasks) {
 			_tasksToProcess.push_back(std::move(task));
 		}
 	}
 
-	wakeThread();
+	wakeThreads();
 }
 
-void TaskQueue::wakeThread() {
-	if (!_thread) {
-		_thread = new QThread();
+void TaskQueue::wakeThreads() {
+	if (_threads.empty()) {
+		for (auto i = 0; i != _threadsCount; ++i) {
+			const auto thread = new QThread();
+			const auto worker = new TaskQueueWorker(this);
+			worker->moveToThread(thread);
 
-		_worker = new TaskQueueWorker(this);
-		_worker->moveToThread(_thread);
+			connect(this, SIGNAL(taskAdded()), worker, SLOT(onTaskAdded()));
+			connect(worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
 
-		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
-		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
-
-		_thread->start();
+			thread->start();
+			_threads.push_back(thread);
+			_workers.push_back(worker);
+		}
 	}
 	if (_stopTimer) _stopTimer->stop();
 	taskAdded();
 }
 
 void TaskQueue::cancelTask(TaskId id) {
-	const auto removeFrom = [&](std::deque<std::unique_ptr<Task>> &queue) {
-		const auto proj = [](const std::unique_ptr<Task> &task) {
-			return task->id();
-		};
-		auto i = ranges::find(queue, id, proj);
-		if (i != queue.end()) {
-			queue.erase(i);
-		}
+	const auto proj = [](const std::unique_ptr<Task> &task) {
+		return task->id();
 	};
-	{
-		QMutexLocker lock(&_tasksToProcessMutex);
-		removeFrom(_tasksToProcess);
-		if (_taskInProcessId == id) {
-			_taskInProcessId = TaskId();
+	QMutexLocker lock(&_tasksMutex);
+	const auto i = ranges::find(_tasksToProcess, id, proj);
+	if (i != _tasksToProcess.end()) {
+		_tasksToProcess.erase(i);
+	}
+
+	// If the task is still in process the worker will just destroy it.
+	const auto j = ranges::find(_tasksStarted, id, &Started::id);
+	if (j != _tasksStarted.end()) {
+		const auto wasFirst = (j == _tasksStarted.begin());
+		_tasksStarted.erase(j);
+		if (wasFirst
+			&& !_tasksStarted.empty()
+			&& _tasksStarted.front().processed) {
+			crl::on_main(this, [=] { onTaskProcessed(); });
 		}
 	}
-	QMutexLocker lock(&_tasksToFinishMutex);
-	removeFrom(_tasksToFinish);
 }
 
 void TaskQueue::onTaskProcessed() {
 	do {
 		auto task = std::unique_ptr<Task>();
 		{
-			QMutexLocker lock(&_tasksToFinishMutex);
-			if (_tasksToFinish.empty()) break;
-			task = std::move(_tasksToFinish.front());
-			_tasksToFinish.pop_front();
+			QMutexLocker lock(&_tasksMutex);
+			if (_tasksStarted.empty() || !_tasksStarted.front().processed) {
+				break;
+			}
+			task = std::move(_tasksStarted.front().processed);
+			_tasksStarted.pop_front();
 		}
 		task->finish();
 	} while (true);
 
 	if (_stopTimer) {
-		QMutexLocker lock(&_tasksToProcessMutex);
-		if (_tasksToProcess.empty() && !_taskInProcessId) {
+		QMutexLocker lock(&_tasksMutex);
+		if (_tasksToProcess.empty() && _tasksStarted.empty()) {
 			_stopTimer->start();
 		}
 	}
 }
 
 void TaskQueue::stop() {
-	if (_thread) {
-		_thread->requestInterruption();
-		_thread->quit();
-		DEBUG_LOG(("Waiting for taskThread to finish"));
-		_thread->wait();
-		delete base::take(_worker);
-		delete base::take(_thread);
+	for (const auto thread : _threads) {
+		thread->requestInterruption();
+		thread->quit();
+	}
+	if (!_threads.empty()) {
+		DEBUG_LOG(("Waiting for taskThreads to finish"));
+	}
+	for (const auto thread : base::take(_threads)) {
+		thread->wait();
+		delete thread;
+	}
+	for (const auto worker : base::take(_workers)) {
+		delete worker;
 	}
 	_tasksToProcess.clear();
-	_tasksToFinish.clear();
-	_taskInProcessId = TaskId();
+	_tasksStarted.clear();
 }
 
 TaskQueue::~TaskQueue() {
@@ -347,27 +360,28 @@ void TaskQueueWorker::onTaskAdded() {
 	do {
 		auto task = std::unique_ptr<Task>();
 		{
-			QMutexLocker lock(&_queue->_tasksToProcessMutex);
+			QMutexLocker lock(&_queue->_tasksMutex);
 			if (!_queue->_tasksToProcess.empty()) {
 				task = std::move(_queue->_tasksToProcess.front());
 				_queue->_tasksToProcess.pop_front();
-				_queue->_taskInProcessId = task->id();
+				_queue->_tasksStarted.push_back({ .id = task->id() });
 			}
 		}
 
+		someTasksLeft = false;
 		if (task) {
 			task->process();
 			bool emitTaskProcessed = false;
 			{
-				QMutexLocker lockToProcess(&_queue->_tasksToProcessMutex);
-				if (_queue->_taskInProcessId == task->id()) {
-					_queue->_taskInProcessId = TaskId();
-					someTasksLeft = !_queue->_tasksToProcess.empty();
-
-					QMutexLocker lockToFinish(&_queue->_tasksToFinishMutex);
-					emitTaskProcessed = _queue->_tasksToFinish.empty();
-					_queue->_tasksToFinish.push_back(std::move(task));
+				QMutexLocker lock(&_queue->_tasksMutex);
+				using Started = TaskQueue::Started;
+				auto &started = _queue->_tasksStarted;
+				const auto i = ranges::find(started, task->id(), &Started::id);
+				if (i != started.end()) {
+					i->processed = std::move(task);
+					emitTaskProcessed = (i == started.begin());
 				}
+				someTasksLeft = !_queue->_tasksToProcess.empty();
 			}
 			if (emitTaskProcessed) {
 				taskProcessed();
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "tdb/details/tdb_instance.h"
 
+#include "tdb/details/tdb_request_table.h"
 #include "base/atomic.h"
 #include "base/debug_log.h"
 
@@ -14,12 +15,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtCore/QDir>
 
 #include <thread>
+#include <unordered_set>
 #include <td/telegram/Client.h>
 
 namespace Tdb::details {
 namespace {
 
 constexpr auto kPurgeInvalidLimit = 1024;
+constexpr auto kMaxReceivedBatch = 1024;
 
 using namespace ::td;
 using ClientId = ClientManager::ClientId;
@@ -169,14 +172,30 @@ public:
 		RequestId requestId,
 		ExternalGenerator &&request,
 		ExternalCallback &&callback);
+	void enqueueCancel(RequestId requestId);
 
 private:
+	struct Received {
+		ClientId clientId = 0;
+		RequestId requestId = 0;
+		std::optional<TLupdate> update;
+		FnMut<void()> handler;
+	};
+
 	void sendToTdManager(
 		ClientId id,
 		api::object_ptr<api::Function> request,
 		RequestId requestId);
 	void loop();
+	void receive(
+		ClientManager::Response &&response,
+		bool stopping,
+		std::vector<Received> &batch);
 
+	void handleBatchOnMain(std::vector<Received> &&batch);
+	void handleUpdatesOnMain(
+		ClientId clientId,
+		std::vector<TLupdate> &&updates);
 	void handleUpdateOnMain(ClientId clientId, TLupdate &&update);
 	void handleResponseOnMain(
 		ClientId clientId,
@@ -197,8 +216,7 @@ private:
 	// Lives on _thread.
 	base::flat_set<ClientId> _closed;
 
-	QMutex _mutex;
-	base::flat_map<RequestId, ExternalCallback> _callbacks;
+	RequestTable _callbacks;
 
 	base::flat_set<QString> _clearingPaths;
 
@@ -267,9 +285,10 @@ public:
 			skipStateCheck);
 	}
 
+	void handleUpdates(std::vector<TLupdate> &&updates);
 	void handleUpdate(TLupdate &&update);
 	void purgeInvalidDone();
-	[[nodiscard]] rpl::producer<TLupdate> updates() const;
+	[[nodiscard]] rpl::producer<std::vector<TLupdate>> updateBatches() const;
 	void logout();
 	void reset();
 
@@ -299,16 +318,17 @@ private:
 	void clearStale();
 	void started();
 	void setCurrentProxy();
+	void fireUpdate(TLupdate &&update);
 	[[nodiscard]] bool shouldInvokeHandler(RequestId requestId);
 
 	const std::shared_ptr<Manager> _manager;
 	ClientManager::ClientId _id = 0;
 	InstanceConfig _config;
 	QMutex _activeRequestsMutex;
-	base::flat_set<RequestId> _activeRequests;
+	std::unordered_set<RequestId> _activeRequests;
 	base::flat_map<RequestId, QueuedRequest> _queuedRequests;
 	std::variant<TLdisableProxy, TLaddProxy> _proxy;
-	rpl::event_stream<TLupdate> _updates;
+	rpl::event_stream<std::vector<TLupdate>> _updates;
 	std::vector<PausedProcess> _pausedProcesses;
 	base::atomic<State> _state = State::Working;
 	base::atomic<bool> _clearingStale = false;
@@ -503,7 +523,6 @@ void Instance::Manager::enqueueSend(
 	]() mutable {
 		const auto raw = that.get();
 		if (callback) {
-			QMutexLocker lock(&raw->_mutex);
 			raw->_callbacks.emplace(requestId, std::move(callback));
 		}
 		raw->sendToTdManager(
@@ -513,6 +532,15 @@ void Instance::Manager::enqueueSend(
 	});
 }
 
+void Instance::Manager::enqueueCancel(RequestId requestId) {
+	// Forget the callback so that the response to a cancelled request
+	// is dropped right away on the TDLib thread, without converting it.
+	// This goes through _queue to be ordered after enqueueSend.
+	_queue->async([that = shared_from_this(), requestId] {
+		that->_callbacks.remove(requestId);
+	});
+}
+
 void Instance::Manager::sendToTdManager(
 		ClientId id,
 		api::object_ptr<api::Function> request,
@@ -522,63 +550,119 @@ void Instance::Manager::sendToTdManager(
 
 void Instance::Manager::loop() {
 	auto stopping = false;
-	while (!stopping || !_waitingForClose.empty()) {
+	auto batch = std::vector<Received>();
+	const auto finished = [&] {
+		return stopping && _waitingForClose.empty();
+	};
+	while (!finished()) {
 		auto response = _tdmanager->receive(60.);
-		if (!response.object) {
-			continue;
-		}
-		if (!stopping && _stopRequested) {
-			stopping = true;
-			for (const auto clientId : base::take(_closed)) {
-				_waitingForClose.remove(clientId);
-			}
-		}
-		if (RequestAbortedError(response)) {
-			continue;
-		}
-		const auto clientId = response.client_id;
-		const auto requestId = RequestId(response.request_id);
-		const auto object = response.object.get();
-		if (!requestId) {
-			auto update = tl_from<TLupdate>(object);
-			if (ClientClosedUpdate(update)) {
-				LOG(("Tdb Info: Client %1 finished closing.").arg(clientId));
-				if (stopping) {
+		while (response.object) {
+			if (!stopping && _stopRequested) {
+				stopping = true;
+				for (const auto clientId : base::take(_closed)) {
 					_waitingForClose.remove(clientId);
-				} else {
-					_closed.emplace(clientId);
 				}
 			}
+			receive(std::move(response), stopping, batch);
+
+			// Drain everything TDLib already has ready, so that a burst
+			// of updates reaches the main thread in a single wakeup.
+			if (finished() || batch.size() >= kMaxReceivedBatch) {
+				break;
+			}
+			response = _tdmanager->receive(0.);
+		}
+		if (!batch.empty()) {
 			crl::on_main(weak_from_this(), [
 				this,
-				clientId,
-				update = std::move(update)
+				batch = base::take(batch)
 			]() mutable {
-				handleUpdateOnMain(clientId, std::move(update));
+				handleBatchOnMain(std::move(batch));
 			});
-			continue;
 		}
-		QMutexLocker lock(&_mutex);
-		auto callback = _callbacks.take(requestId);
-		lock.unlock();
-
-		if (!callback) {
-			//if (_waitingForClose[clientId] == requestId) {
-			//	_waitingForClose.remove(clientId);
-			//}
-			if (const auto error = ParseError(object)) {
-				LogError(uint32(-1), requestId, *error);
+	}
+}
+
+void Instance::Manager::receive(
+		ClientManager::Response &&response,
+		bool stopping,
+		std::vector<Received> &batch) {
+	if (RequestAbortedError(response)) {
+		return;
+	}
+	const auto clientId = response.client_id;
+	const auto requestId = RequestId(response.request_id);
+	const auto object = response.object.get();
+	if (!requestId) {
+		auto update = tl_from<TLupdate>(object);
+		if (ClientClosedUpdate(update)) {
+			LOG(("Tdb Info: Client %1 finished closing.").arg(clientId));
+			if (stopping) {
+				_waitingForClose.remove(clientId);
+			} else {
+				_closed.emplace(clientId);
 			}
-			continue;
 		}
-		crl::on_main(weak_from_this(), [
-			this,
-			clientId,
-			requestId,
-			handler = (*callback)(requestId, object)
-		]() mutable {
-			handleResponseOnMain(clientId, requestId, std::move(handler));
+		batch.push_back({
+			.clientId = clientId,
+			.update = std::move(update),
 		});
+		return;
+	}
+	auto callback = _callbacks.take(requestId);
+	if (!callback) {
+		//if (_waitingForClose[clientId] == requestId) {
+		//	_waitingForClose.remove(clientId);
+		//}
+		if (const auto error = ParseError(object)) {
+			LogError(uint32(-1), requestId, *error);
+		}
+		return;
+	}
+	batch.push_back({
+		.clientId = clientId,
+		.requestId = requestId,
+		.handler = callback(requestId, object),
+	});
+}
+
+void Instance::Manager::handleBatchOnMain(std::vector<Received> &&batch) {
+	auto updatesClientId = ClientId();
+	auto updates = std::vector<TLupdate>();
+	const auto flushUpdates = [&] {
+		if (!updates.empty()) {
+			handleUpdatesOnMain(updatesClientId, base::take(updates));
+		}
+	};
+	for (auto &received : batch) {
+		if (!received.update) {
+			flushUpdates();
+			handleResponseOnMain(
+				received.clientId,
+				received.requestId,
+				std::move(received.handler));
+		} else if (ClientClosedUpdate(*received.update)) {
+			flushUpdates();
+			handleUpdateOnMain(
+				received.clientId,
+				std::move(*received.update));
+		} else {
+			if (updatesClientId != received.clientId) {
+				flushUpdates();
+				updatesClientId = received.clientId;
+			}
+			updates.push_back(std::move(*received.update));
+		}
+	}
+	flushUpdates();
+}
+
+void Instance::Manager::handleUpdatesOnMain(
+		ClientId clientId,
+		std::vector<TLupdate> &&updates) {
+	const auto i = _clients.find(clientId);
+	if (i != end(_clients)) {
+		i->second->handleUpdates(std::move(updates));
 	}
 }
 
@@ -754,11 +838,16 @@ void Instance::Client::sendToManager(
 }
 
 void Instance::Client::cancel(RequestId requestId) {
+	auto active = false;
 	{
 		QMutexLocker lock(&_activeRequestsMutex);
-		_activeRequests.remove(requestId);
+		active = (_activeRequests.erase(requestId) > 0);
+	}
+
+	// Requests without a callback are queued but never marked active.
+	if (!_queuedRequests.remove(requestId) && active) {
+		_manager->enqueueCancel(requestId);
 	}
-	_queuedRequests.remove(requestId);
 }
 
 bool Instance::Client::shouldInvokeHandler(RequestId requestId) {
@@ -795,6 +884,33 @@ void Instance::Client::started() {
 	}
 }
 
+void Instance::Client::handleUpdates(std::vector<TLupdate> &&updates) {
+	Expects(_state != State::Purging);
+
+	if (_paused) {
+		for (auto &update : updates) {
+			_pausedProcesses.push_back(std::move(update));
+		}
+		return;
+	}
+	auto batch = std::vector<TLupdate>();
+	batch.reserve(updates.size());
+	for (auto &update : updates) {
+		if (update.type() == id_updateAuthorizationState) {
+			// State changes may restart the client, keep them in order.
+			if (!batch.empty()) {
+				_updates.fire(base::take(batch));
+			}
+			handleUpdate(std::move(update));
+		} else {
+			batch.push_back(std::move(update));
+		}
+	}
+	if (!batch.empty()) {
+		_updates.fire(std::move(batch));
+	}
+}
+
 void Instance::Client::handleUpdate(TLupdate &&update) {
 	Expects(_state != State::Purging);
 
@@ -811,19 +927,25 @@ void Instance::Client::handleUpdate(TLupdate &&update) {
 			_state = State::Closing;
 		}, [&](const TLDauthorizationStateClosed &) {
 			_state = State::Closed;
-			_updates.fire(std::move(update));
+			fireUpdate(std::move(update));
 			if (!_queuedRequests.empty() && _state == State::Closed) {
 				restart();
 			}
 		}, [&](const auto &) {
 			started();
-			_updates.fire(std::move(update));
+			fireUpdate(std::move(update));
 		});
 	}, [&](const auto &) {
-		_updates.fire(std::move(update));
+		fireUpdate(std::move(update));
 	});
 }
 
+void Instance::Client::fireUpdate(TLupdate &&update) {
+	auto batch = std::vector<TLupdate>();
+	batch.push_back(std::move(update));
+	_updates.fire(std::move(batch));
+}
+
 void Instance::Client::purgeInvalidDone() {
 	if (_state != State::PurgeDone) {
 		return;
@@ -836,7 +958,8 @@ void Instance::Client::purgeInvalidDone() {
 	handleUpdate(tl_updateAuthorizationState(tl_authorizationStateClosed()));
 }
 
-rpl::producer<TLupdate> Instance::Client::updates() const {
+auto Instance::Client::updateBatches() const
+-> rpl::producer<std::vector<TLupdate>> {
 	return _updates.events();
 }
 
@@ -875,16 +998,26 @@ void Instance::Client::setPaused(bool paused) {
 		_paused = true;
 	} else {
 		_paused = false;
+
+		// Updates received while paused are delivered in batches.
+		auto updates = std::vector<TLupdate>();
+		const auto flushUpdates = [&] {
+			if (!updates.empty()) {
+				handleUpdates(base::take(updates));
+			}
+		};
 		for (auto &process : base::take(_pausedProcesses)) {
 			if (const auto update = std::get_if<TLupdate>(&process)) {
-				handleUpdate(std::move(*update));
+				updates.push_back(std::move(*update));
 			} else {
+				flushUpdates();
 				auto &paused = v::get<PausedHandler>(process);
 				if (shouldInvokeHandler(paused.requestId)) {
 					paused.handler();
 				}
 			}
 		}
+		flushUpdates();
 	}
 }
 
@@ -1069,8 +1202,8 @@ void Instance::cancel(RequestId requestId) {
 	_client->cancel(requestId);
 }
 
-rpl::producer<TLupdate> Instance::updates() const {
-	return _client->updates();
+rpl::producer<std::vector<TLupdate>> Instance::updateBatches() const {
+	return _client->updateBatches();
 }
 
 void Instance::logout() {
@@ -106,7 +106,8 @@ public:
 	void cancel(RequestId requestId);
 
 	// Main thread.
-	[[nodiscard]] rpl::producer<TLupdate> updates() const;
+	// Updates arrive in batches, one batch per main thread wakeup.
+	[[nodiscard]] rpl::producer<std::vector<TLupdate>> updateBatches() const;
 	void logout();
 	void reset();
 
@@ -0,0 +1,42 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "tdb/details/tdb_request_table.h"
+
+namespace Tdb::details {
+
+auto RequestTable::shard(RequestId requestId) -> Shard & {
+	return _shards[uint64(requestId) % kShardsCount];
+}
+
+void RequestTable::emplace(
+		RequestId requestId,
+		ExternalCallback &&callback) {
+	auto &shard = this->shard(requestId);
+	QMutexLocker lock(&shard.mutex);
+	shard.callbacks.emplace(requestId, std::move(callback));
+}
+
+ExternalCallback RequestTable::take(RequestId requestId) {
+	auto &shard = this->shard(requestId);
+	QMutexLocker lock(&shard.mutex);
+	const auto i = shard.callbacks.find(requestId);
+	if (i == end(shard.callbacks)) {
+		return nullptr;
+	}
+	auto result = std::move(i->second);
+	shard.callbacks.erase(i);
+	return result;
+}
+
+void RequestTable::remove(RequestId requestId) {
+	auto &shard = this->shard(requestId);
+	QMutexLocker lock(&shard.mutex);
+	shard.callbacks.erase(requestId);
+}
+
+} // namespace Tdb::details
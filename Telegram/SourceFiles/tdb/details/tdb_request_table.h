@@ -0,0 +1,44 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "tdb/details/tdb_tl_core_external.h"
+#include "tdb/tdb_request_id.h"
+
+#include <QtCore/QMutex>
+
+#include <array>
+#include <unordered_map>
+
+namespace Tdb::details {
+
+// Callbacks of the requests in flight, inserted from the send queue and
+// taken from the TDLib thread. Request ids grow monotonically, so they
+// are spread between shards uniformly and every shard is a hash map,
+// without the insert / erase shifting of a flat_map.
+class RequestTable final {
+public:
+	void emplace(RequestId requestId, ExternalCallback &&callback);
+	[[nodiscard]] ExternalCallback take(RequestId requestId);
+	void remove(RequestId requestId);
+
+private:
+	static constexpr auto kShardsCount = 16;
+
+	struct Shard {
+		QMutex mutex;
+		std::unordered_map<RequestId, ExternalCallback> callbacks;
+	};
+
+	[[nodiscard]] Shard &shard(RequestId requestId);
+
+	std::array<Shard, kShardsCount> _shards;
+
+};
+
+} // namespace Tdb::details
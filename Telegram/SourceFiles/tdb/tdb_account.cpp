@@ -18,11 +18,15 @@ Account::Account(AccountConfig &&config)
 , _sender(&_instance)
 , _options(std::make_unique<Options>(&_sender))
 , _downloader(std::make_unique<FilesDownloader>(this)) {
-	_instance.updates(
-	) | rpl::start_with_next([=](TLupdate &&update) {
-		if (!consumeUpdate(update)) {
-			_updates.fire(std::move(update));
+	_instance.updateBatches(
+	) | rpl::start_with_next([=](std::vector<TLupdate> &&updates) {
+		_updateBatchActive.fire(true);
+		for (auto &update : updates) {
+			if (!consumeUpdate(update)) {
+				_updates.fire(std::move(update));
+			}
 		}
+		_updateBatchActive.fire(false);
 	}, _lifetime);
 }
 
@@ -44,6 +48,10 @@ rpl::producer<TLupdate> Account::updates() const {
 	return _updates.events();
 }
 
+rpl::producer<bool> Account::updateBatchActive() const {
+	return _updateBatchActive.events();
+}
+
 void Account::registerFileGenerator(not_null<FileGenerator*> generator) {
 	_generators.emplace(generator->conversion(), generator);
 }
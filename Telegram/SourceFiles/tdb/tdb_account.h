@@ -35,6 +35,10 @@ public:
 	}
 
 	[[nodiscard]] rpl::producer<TLupdate> updates() const;
+
+	// Fires true before and false after each batch of updates().
+	[[nodiscard]] rpl::producer<bool> updateBatchActive() const;
+
 	void logout();
 	void reset();
 
@@ -62,6 +66,7 @@ private:
 	Sender _sender;
 	std::unique_ptr<Options> _options;
 	rpl::event_stream<TLupdate> _updates;
+	rpl::event_stream<bool> _updateBatchActive;
 
 	std::unique_ptr<FilesDownloader> _downloader;
 	base::flat_map<QString, not_null<FileGenerator*>> _generators;
@@ -15,6 +15,7 @@ namespace Tdb {
 namespace {
 
 constexpr auto kChunk = 128 * 1024;
+constexpr auto kPartsInFlight = 4;
 
 } // namespace
 
@@ -47,25 +48,45 @@ void FileGenerator::start(int64 id) {
 	if (!updateGeneration(id)) {
 		return;
 	}
-	const auto writePart = [=](const auto &repeat) -> void {
+	_generationOffset = 0;
+	_partsInFlight = 0;
+	if (_content.isEmpty()) {
+		finish();
+	} else {
+		sendParts();
+	}
+}
+
+void FileGenerator::sendParts() {
+	// Keep several parts in flight instead of waiting for each one.
+	// TDLib handles them in order, so the file is written the same way.
+	const auto size = Offset(_content.size());
+	while (_generationId
+		&& _partsInFlight < kPartsInFlight
+		&& _generationOffset < size) {
+		const auto id = _generationId;
+		const auto offset = _generationOffset;
+		const auto length = std::min(Offset(kChunk), size - offset);
+		_generationOffset += length;
+		++_partsInFlight;
 		_api.request(TLwriteGeneratedFilePart(
-			tl_int64(_generationId),
-			tl_int53(_generationOffset),
-			tl_bytes(_content.mid(
-				_generationOffset,
-				std::min(kChunk, int(_content.size()) - _generationOffset)))
+			tl_int64(id),
+			tl_int53(offset),
+			tl_bytes(_content.mid(qsizetype(offset), qsizetype(length)))
 		)).done([=] {
-			_generationOffset += kChunk;
-			if (_generationOffset >= _content.size()) {
+			if (_generationId != id) {
+				return;
+			} else if (!--_partsInFlight && _generationOffset >= size) {
 				finish();
-			} else if (_generationId) {
-				repeat(repeat);
+			} else {
+				sendParts();
 			}
 		}).fail([=](const Error &error) {
-			cancel(error.code, error.message);
+			if (_generationId == id) {
+				cancel(error.code, error.message);
+			}
 		}).send();
-	};
-	writePart(writePart);
+	}
 }
 
 void FileGenerator::finish() {
@@ -17,7 +17,7 @@ class Account;
 
 class FileGenerator final {
 public:
-	using Offset = int;
+	using Offset = int64;
 
 	FileGenerator(
 		not_null<Account*> account,
@@ -36,6 +36,7 @@ public:
 
 private:
 	bool updateGeneration(int64 id);
+	void sendParts();
 	void cancel(int code, const QString &message);
 
 	const not_null<Account*> _account;
@@ -46,6 +47,7 @@ private:
 	Sender _api;
 	int64 _generationId = 0;
 	Offset _generationOffset = 0;
+	int _partsInFlight = 0;
 
 	rpl::lifetime _lifetime;
 
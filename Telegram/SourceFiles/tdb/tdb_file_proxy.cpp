@@ -8,6 +8,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "tdb/tdb_file_proxy.h"
 
 namespace Tdb::details {
+namespace {
+
+#ifndef Q_OS_WIN
+constexpr auto kMapWindow = int64(64 * 1024 * 1024);
+#endif // !Q_OS_WIN
+
+} // namespace
 
 #ifdef Q_OS_WIN
 
@@ -22,20 +29,33 @@ FileProxyImpl::FileProxyImpl(const QString &path) {
 		nullptr);
 }
 
+FileProxyImpl::~FileProxyImpl() {
+	if (valid()) {
+		CloseHandle(_handle);
+	}
+}
+
 bool FileProxyImpl::valid() const {
 	return (_handle != INVALID_HANDLE_VALUE);
 }
 
-bool FileProxyImpl::seek(int offset) {
-	const auto result = SetFilePointer(_handle, offset, nullptr, FILE_BEGIN);
-	return (result != INVALID_SET_FILE_POINTER);
+bool FileProxyImpl::seek(int64 offset) {
+	auto distance = LARGE_INTEGER();
+	distance.QuadPart = offset;
+	return SetFilePointerEx(_handle, distance, nullptr, FILE_BEGIN);
 }
 
-QByteArray FileProxyImpl::read(int limit) {
-	auto result = QByteArray(limit, Qt::Uninitialized);
+bytes::const_span FileProxyImpl::readView(int64 limit) {
+	if (limit <= 0 || limit > std::numeric_limits<DWORD>::max()) {
+		return {};
+	}
+	_buffer.resize(limit);
 	auto read = DWORD(0);
-	ReadFile(_handle, result.data(), DWORD(limit), &read, nullptr);
-	return (read == limit) ? result : QByteArray();
+	ReadFile(_handle, _buffer.data(), DWORD(limit), &read, nullptr);
+	if (read != limit) {
+		return {};
+	}
+	return bytes::make_span(_buffer);
 }
 
 #else // Q_OS_WIN
@@ -44,16 +64,65 @@ FileProxyImpl::FileProxyImpl(const QString &path) : _file(path) {
 	_file.open(QIODevice::ReadOnly);
 }
 
+FileProxyImpl::~FileProxyImpl() {
+	unmap();
+}
+
 bool FileProxyImpl::valid() const {
 	return _file.isOpen();
 }
 
-bool FileProxyImpl::seek(int offset) {
-	return _file.seek(offset);
+bool FileProxyImpl::seek(int64 offset) {
+	if (offset < 0) {
+		return false;
+	}
+	_position = offset;
+	return true;
+}
+
+bytes::const_span FileProxyImpl::readView(int64 limit) {
+	if (limit <= 0) {
+		return {};
+	} else if (map(_position, limit)) {
+		const auto from = _mapped + (_position - _mappedOffset);
+		_position += limit;
+		return bytes::make_span(from, limit);
+	} else if (!_file.seek(_position)) {
+		return {};
+	}
+	_buffer.resize(limit);
+	if (_file.read(_buffer.data(), limit) != limit) {
+		return {};
+	}
+	_position += limit;
+	return bytes::make_span(_buffer);
+}
+
+bool FileProxyImpl::map(int64 offset, int64 limit) {
+	if (_mapped
+		&& offset >= _mappedOffset
+		&& offset + limit <= _mappedOffset + _mappedSize) {
+		return true;
+	}
+	unmap();
+	const auto size = _file.size();
+	if (offset + limit > size) {
+		return false;
+	}
+	const auto till = std::min(size, offset + std::max(limit, kMapWindow));
+	_mapped = _file.map(offset, till - offset);
+	if (!_mapped) {
+		return false;
+	}
+	_mappedOffset = offset;
+	_mappedSize = till - offset;
+	return true;
 }
 
-QByteArray FileProxyImpl::read(int limit) {
-	return _file.read(limit);
+void FileProxyImpl::unmap() {
+	if (const auto mapped = base::take(_mapped)) {
+		_file.unmap(mapped);
+	}
 }
 
 #endif // Q_OS_WIN
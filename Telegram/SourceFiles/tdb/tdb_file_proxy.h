@@ -7,6 +7,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/bytes.h"
+
 #ifdef Q_OS_WIN
 #include <windows.h>
 #else // Q_OS_WIN
@@ -23,29 +25,42 @@ namespace Tdb::details {
 class FileProxyImpl final {
 public:
 	explicit FileProxyImpl(const QString &path);
+	~FileProxyImpl();
 
 	[[nodiscard]] bool valid() const;
-	[[nodiscard]] bool seek(int offset);
-	[[nodiscard]] QByteArray read(int limit);
+	[[nodiscard]] bool seek(int64 offset);
+	[[nodiscard]] bytes::const_span readView(int64 limit);
 
 private:
 	HANDLE _handle = nullptr;
+	bytes::vector _buffer;
 
 };
 
 #else // Q_OS_WIN
 
-// A simple proxy to QFile on other systems.
+// On other systems the file is memory mapped by windows, which are
+// remapped when a read goes past them, for example when TDLib has written
+// more parts of the file. If mapping fails we fall back to plain reads.
 class FileProxyImpl final {
 public:
 	explicit FileProxyImpl(const QString &path);
+	~FileProxyImpl();
 
 	[[nodiscard]] bool valid() const;
-	[[nodiscard]] bool seek(int offset);
-	[[nodiscard]] QByteArray read(int limit);
+	[[nodiscard]] bool seek(int64 offset);
+	[[nodiscard]] bytes::const_span readView(int64 limit);
 
 private:
+	[[nodiscard]] bool map(int64 offset, int64 limit);
+	void unmap();
+
 	QFile _file;
+	uchar *_mapped = nullptr;
+	int64 _mappedOffset = 0;
+	int64 _mappedSize = 0;
+	int64 _position = 0;
+	QByteArray _buffer;
 
 };
 
@@ -63,11 +78,21 @@ public:
 	[[nodiscard]] bool valid() const {
 		return _impl.valid();
 	}
-	[[nodiscard]] bool seek(int offset) {
+	[[nodiscard]] bool seek(int64 offset) {
 		return _impl.seek(offset);
 	}
-	[[nodiscard]] QByteArray read(int limit) {
-		return _impl.read(limit);
+
+	// Returns an empty array if not all of the requested bytes are there.
+	[[nodiscard]] QByteArray read(int64 limit) {
+		const auto view = _impl.readView(limit);
+		return QByteArray(
+			reinterpret_cast<const char*>(view.data()),
+			view.size());
+	}
+
+	// Doesn't copy, the result is valid until the next seek / read.
+	[[nodiscard]] bytes::const_span readView(int64 limit) {
+		return _impl.readView(limit);
 	}
 
 	[[nodiscard]] static std::unique_ptr<FileProxy> Create(
@@ -17,6 +17,8 @@ namespace Tdb {
 namespace {
 
 constexpr auto kMaxQueries = 8;
+constexpr auto kMaxLargeQueries = 8;
+constexpr auto kLargeFileSize = 1024 * 1024;
 constexpr auto kMaxHttpRedirects = 5;
 constexpr auto kChunk = 128 * 1024;
 constexpr auto kChunksInBuffer = 8;
@@ -31,10 +33,12 @@ struct FilesDownloader::Sent {
 	QString url;
 	not_null<QNetworkReply*> reply;
 	QByteArray data;
+	int filled = 0;
 	base::flat_set<RequestId> requests;
 	int64 sent = 0;
 	int redirectsLeft = kMaxHttpRedirects;
 	bool downloaded = false;
+	bool large = false;
 };
 
 FilesDownloader::FilesDownloader(not_null<Account*> account)
@@ -96,8 +100,18 @@ void FilesDownloader::deleteDeferred(not_null<QNetworkReply*> reply) {
 	_repliesBeingDeleted.emplace_back(reply.get());
 }
 
+int FilesDownloader::smallQueries() const {
+	return int(ranges::count(_sent, false, [](const auto &pair) {
+		return pair.second.large;
+	}));
+}
+
 void FilesDownloader::sendNext() {
-	while (!_enqueued.empty() && _sent.size() < kMaxQueries) {
+	// Large files don't hold the slots of the small ones, so that
+	// thumbnails are not stuck behind several big animations.
+	while (!_enqueued.empty()
+		&& _sent.size() < kMaxQueries + kMaxLargeQueries
+		&& smallQueries() < kMaxQueries) {
 		const auto i = _enqueued.begin();
 		const auto id = i->first;
 		const auto url = i->second.url;
@@ -136,52 +150,79 @@ void FilesDownloader::read(int64 id, not_null<QNetworkReply*> reply) {
 }
 
 void FilesDownloader::read(int64 id, not_null<Sent*> sent) {
+	const auto reply = sent->reply;
 	while (true) {
-		const auto reply = sent->reply;
-		const auto read = reply->read(kChunk);
-		if (read.isEmpty() && (!sent->downloaded || sent->data.isEmpty())) {
+		// Read straight into the chunk that will be sent to TDLib.
+		if (sent->data.size() != kChunk) {
+			sent->data.resize(kChunk);
+		}
+		const auto read = reply->read(
+			sent->data.data() + sent->filled,
+			kChunk - sent->filled);
+		if (read <= 0) {
 			break;
-		} else if (!sent->data.isEmpty()) {
-			sent->data.append(read);
-		} else {
-			sent->data = read;
 		}
-		const auto chunkSize = sent->downloaded
-			? std::min(int(sent->data.size()), kChunk)
-			: kChunk;
-		Assert(chunkSize > 0);
-		while (sent->data.size() >= chunkSize) {
-			const auto exact = (sent->data.size() == chunkSize);
-			const auto rid = _sender.request(TLwriteGeneratedFilePart(
-				tl_int64(id),
-				tl_int53(sent->sent),
-				tl_bytes(exact ? sent->data : sent->data.mid(0, chunkSize))
-			)).done([=](const TLok &, RequestId rid) {
-				written(id, reply, rid);
-			}).fail([=](const Error &error) {
-				finish(id);
-			}).send();
-
-			sent->sent += chunkSize;
-			if (exact) {
-				sent->data = QByteArray();
-			} else {
-				sent->data = sent->data.mid(chunkSize);
-			}
-			sent->requests.emplace(rid);
+		sent->filled += read;
+		if (sent->filled == kChunk) {
+			sendPart(id, sent);
+		}
+	}
+	if (sent->downloaded) {
+		if (sent->filled > 0) {
+			sendPart(id, sent);
+		} else if (sent->requests.empty()) {
+			finishGeneration(id);
+			return;
+		}
+	}
+	if (!sent->large) {
+		const auto length = reply->header(
+			QNetworkRequest::ContentLengthHeader).toLongLong();
+		if (std::max(int64(length), sent->sent) >= kLargeFileSize) {
+			sent->large = true;
+			sendNext();
 		}
 	}
 }
 
+void FilesDownloader::sendPart(int64 id, not_null<Sent*> sent) {
+	Expects(sent->filled > 0);
+
+	const auto reply = sent->reply;
+	const auto size = base::take(sent->filled);
+	auto bytes = base::take(sent->data);
+	if (bytes.size() != size) {
+		bytes.resize(size);
+	}
+	const auto rid = _sender.request(TLwriteGeneratedFilePart(
+		tl_int64(id),
+		tl_int53(sent->sent),
+		tl_bytes(std::move(bytes))
+	)).done([=](const TLok &, RequestId rid) {
+		written(id, reply, rid);
+	}).fail([=](const Error &error) {
+		finish(id);
+	}).send();
+
+	sent->sent += size;
+	sent->requests.emplace(rid);
+}
+
+void FilesDownloader::finishGeneration(int64 id) {
+	_sender.request(TLfinishFileGeneration(
+		tl_int64(id),
+		std::nullopt
+	)).send();
+	finish(id);
+}
+
 void FilesDownloader::written(int64 id, not_null<QNetworkReply*> reply, RequestId rid) {
 	if (const auto sent = findSent(id, reply)) {
 		sent->requests.erase(rid);
-		if (sent->downloaded && sent->requests.empty()) {
-			_sender.request(TLfinishFileGeneration(
-				tl_int64(id),
-				std::nullopt
-			)).send();
-			finish(id);
+		if (sent->downloaded
+			&& !sent->filled
+			&& sent->requests.empty()) {
+			finishGeneration(id);
 		}
 	}
 }
@@ -261,6 +302,7 @@ void FilesDownloader::redirect(int id, not_null<QNetworkReply*> reply) {
 		return;
 	}
 	deleteDeferred(reply);
+	sent->filled = 0;
 	sent->url = url;
 	sent->reply = send(id, url);
 }
@@ -47,6 +47,7 @@ private:
 	struct Enqueued;
 	struct Sent;
 
+	[[nodiscard]] int smallQueries() const;
 	void sendNext();
 	[[nodiscard]] not_null<QNetworkReply*> send(
 		int64 id,
@@ -58,6 +59,8 @@ private:
 
 	void read(int64 id, not_null<QNetworkReply*> reply);
 	void read(int64 id, not_null<Sent*> sent);
+	void sendPart(int64 id, not_null<Sent*> sent);
+	void finishGeneration(int64 id);
 	void written(int64 id, not_null<QNetworkReply*> reply, RequestId rid);
 	void finished(int64 id, not_null<QNetworkReply*> reply);
 	void redirect(int id, not_null<QNetworkReply*> reply);
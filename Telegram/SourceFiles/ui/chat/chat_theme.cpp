@@ -17,6 +17,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/style/style_palette_colorizer.h"
 
 #include <crl/crl_async.h>
+#include <QtCore/QMutex>
 #include <QtGui/QGuiApplication>
 
 namespace Ui {
@@ -29,6 +30,98 @@ constexpr auto kMinimumTiledSize = 512;
 constexpr auto kMaxSize = 2960;
 constexpr auto kMaxContrastValue = 21.;
 constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
+constexpr auto kGradientCacheLimit = 16;
+
+enum class GradientType {
+	Plain,
+	Dithered,
+	Linear,
+};
+
+struct GradientKey {
+	std::vector<QRgb> colors;
+	int width = 0;
+	int height = 0;
+	int rotation = 0;
+	float64 progress = 1.;
+	GradientType type = GradientType::Plain;
+
+	friend inline bool operator==(
+		const GradientKey &,
+		const GradientKey &) = default;
+};
+
+// Gradients are shared by all chat themes and the window background.
+// Themes of different chats often use the same wallpaper colors, and
+// rotating a complex gradient cycles through a small set of states.
+struct GradientCache {
+	QMutex mutex;
+	std::vector<std::pair<GradientKey, QImage>> list; // Recent are last.
+};
+
+[[nodiscard]] GradientCache &Gradients() {
+	static auto result = GradientCache();
+	return result;
+}
+
+[[nodiscard]] QImage CachedGradient(
+		GradientKey &&key,
+		FnMut<QImage()> generate) {
+	auto &cache = Gradients();
+	{
+		QMutexLocker lock(&cache.mutex);
+		const auto i = ranges::find(
+			cache.list,
+			key,
+			&std::pair<GradientKey, QImage>::first);
+		if (i != end(cache.list)) {
+			std::rotate(i, i + 1, end(cache.list));
+			return cache.list.back().second;
+		}
+	}
+	auto result = generate();
+
+	QMutexLocker lock(&cache.mutex);
+	if (cache.list.size() >= kGradientCacheLimit) {
+		cache.list.erase(begin(cache.list));
+	}
+	cache.list.emplace_back(std::move(key), result);
+	return result;
+}
+
+[[nodiscard]] GradientKey PrepareGradientKey(
+		QSize size,
+		const std::vector<QColor> &colors,
+		int rotation,
+		float64 progress,
+		GradientType type) {
+	return {
+		.colors = colors | ranges::views::transform(
+			&QColor::rgba
+		) | ranges::to_vector,
+		.width = size.width(),
+		.height = size.height(),
+		.rotation = rotation,
+		.progress = progress,
+		.type = type,
+	};
+}
+
+[[nodiscard]] QImage GenerateCachedGradient(
+		QSize size,
+		const std::vector<QColor> &colors,
+		int rotation,
+		float64 progress = 1.) {
+	auto key = PrepareGradientKey(
+		size,
+		colors,
+		rotation,
+		progress,
+		GradientType::Plain);
+	return CachedGradient(std::move(key), [&] {
+		return Images::GenerateGradient(size, colors, rotation, progress);
+	});
+}
 
 [[nodiscard]] QColor DefaultBackgroundColor() {
 	return QColor(213, 223, 233);
@@ -61,7 +154,7 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 	const auto gradient = request.background.gradientForFill.isNull()
 		? QImage()
 		: (request.gradientRotationAdd != 0)
-		? Images::GenerateGradient(
+		? GenerateCachedGradient(
 			request.background.gradientForFill.size(),
 			request.background.colors,
 			ComputeRealRotation(request),
@@ -157,7 +250,16 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 		return QImage();
 	}
 	constexpr auto kSize = 512;
-	return Images::GenerateLinearGradient(QSize(kSize, kSize), data.colors);
+	const auto size = QSize(kSize, kSize);
+	auto key = PrepareGradientKey(
+		size,
+		data.colors,
+		0,
+		1.,
+		GradientType::Linear);
+	return CachedGradient(std::move(key), [&] {
+		return Images::GenerateLinearGradient(size, data.colors);
+	});
 }
 
 } // namespace
@@ -678,7 +780,7 @@ void ChatTheme::cacheBubbles() {
 
 void ChatTheme::cacheBubblesNow() {
 	if (!_bubblesCachingRequest) {
-		if (const auto request = cacheBackgroundRequest(
+		if (const auto request = cacheBubblesRequest(
 				_cacheBubblesArea)) {
 			cacheBubblesAsync(request);
 		}
@@ -1011,13 +1113,20 @@ QImage GenerateDitheredGradient(
 	constexpr auto kSize = 512;
 	const auto size = QSize(kSize, kSize);
 	if (colors.empty()) {
-		return Images::GenerateGradient(size, { DefaultBackgroundColor() });
-	}
-	auto result = Images::GenerateGradient(size, colors, rotation);
-	if (colors.size() > 1) {
-		result = Images::DitherImage(std::move(result));
+		return GenerateCachedGradient(size, { DefaultBackgroundColor() }, 0);
+	} else if (colors.size() == 1) {
+		return GenerateCachedGradient(size, colors, rotation);
 	}
-	return result;
+	auto key = PrepareGradientKey(
+		size,
+		colors,
+		rotation,
+		1.,
+		GradientType::Dithered);
+	return CachedGradient(std::move(key), [&] {
+		return Images::DitherImage(
+			Images::GenerateGradient(size, colors, rotation));
+	});
 }
 
 ChatThemeBackground PrepareBackgroundImage(
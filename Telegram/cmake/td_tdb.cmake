@@ -47,6 +47,8 @@ PRIVATE
     tdb/details/tdb_tl_generate.py
     tdb/details/tdb_instance.cpp
     tdb/details/tdb_instance.h
+    tdb/details/tdb_request_table.cpp
+    tdb/details/tdb_request_table.h
 )
 
 target_sources(td_tdb PRIVATE ${src_loc}/tdb/td_api.tl)